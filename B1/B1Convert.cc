@@ -0,0 +1,448 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Convert.cc
+/// \brief Converter of the run_N.dat step files to a ROOT file
+///
+/// Replaces the CreateRunFile.C macro:
+///   B1Convert [-o run.root] [-j nofThreads] [-k] [file.dat ...]
+/// Without input files, all run_*.dat files of the current directory are
+/// converted, in natural order (run_2 before run_10). The files are
+/// parsed in parallel, each one into its own tree written to
+/// <output>_<k>.root; the parts are then merged into the tree "tree" of
+/// the output file by TFileMerger, which copies the compressed baskets.
+/// With -k the parts are kept.
+///
+/// The columns are read from the TTree::ReadFile descriptor in the first
+/// line of each file (e.g. EventID/I:particle/C:...), so the tree has the
+/// same branches as the one built by CreateRunFile.C; all the files must
+/// have the same descriptor. The events_N.dat summaries, with their
+/// eventSeed/L column, are converted when given as input files.
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TFileMerger.h>
+#include <TSystem.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+namespace
+{
+  // as B1RootStepWriter: LZ4, level 4
+  const Int_t kCompression = 404;
+
+  // size of the buffer of a C column, including the terminating zero
+  const std::size_t kMaxStringLength = 64;
+
+  struct Column
+  {
+    std::string name;
+    char        type;   // 'I', 'L', 'D' or 'C'
+    std::size_t index;  // in the buffers of its type
+  };
+
+  struct Shard
+  {
+    std::string input;
+    std::string output;
+    Long64_t    nofEntries;
+    Long64_t    nofBadLines;
+    bool        ok;
+  };
+
+  // the branch buffers of a type: 0 to 3 for I, L, D and C, -1 if unknown
+  inline int TypeIndex(char type)
+  {
+    switch ( type ) {
+      case 'I': return 0;
+      case 'L': return 1;
+      case 'D': return 2;
+      case 'C': return 3;
+      default:  return -1;
+    }
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  // compares the names with their digit sequences taken as numbers
+  bool NaturalLess(const std::string& a, const std::string& b)
+  {
+    std::size_t i = 0, j = 0;
+    while ( i < a.size() && j < b.size() ) {
+      if ( std::isdigit(a[i]) && std::isdigit(b[j]) ) {
+        std::size_t iEnd = i, jEnd = j;
+        while ( iEnd < a.size() && std::isdigit(a[iEnd]) ) ++iEnd;
+        while ( jEnd < b.size() && std::isdigit(b[jEnd]) ) ++jEnd;
+        unsigned long long x = std::strtoull(a.c_str() + i, 0, 10);
+        unsigned long long y = std::strtoull(b.c_str() + j, 0, 10);
+        if ( x != y ) return x < y;
+        i = iEnd;
+        j = jEnd;
+      }
+      else {
+        if ( a[i] != b[j] ) return a[i] < b[j];
+        ++i;
+        ++j;
+      }
+    }
+    return a.size() - i < b.size() - j;
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  std::vector<std::string> FindInputs()
+  {
+    std::vector<std::string> inputs;
+    void* directory = gSystem->OpenDirectory(".");
+    if ( ! directory ) return inputs;
+
+    const char* entry;
+    while ( ( entry = gSystem->GetDirEntry(directory) ) ) {
+      std::string name = entry;
+      if ( name.size() > 8 && name.compare(0, 4, "run_") == 0 &&
+           name.compare(name.size() - 4, 4, ".dat") == 0 ) {
+        inputs.push_back(name);
+      }
+    }
+    gSystem->FreeDirectory(directory);
+
+    std::sort(inputs.begin(), inputs.end(), NaturalLess);
+    return inputs;
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  // parses "name/T:name/T:..." into columns
+  bool ParseDescriptor(const std::string& descriptor,
+                       std::vector<Column>& columns)
+  {
+    columns.clear();
+    std::size_t nofValues[4] = { 0, 0, 0, 0 };
+
+    std::size_t begin = 0;
+    while ( begin <= descriptor.size() ) {
+      std::size_t end = descriptor.find(':', begin);
+      if ( end == std::string::npos ) end = descriptor.size();
+      std::string leaf = descriptor.substr(begin, end - begin);
+      begin = end + 1;
+
+      // trailing blanks and carriage return
+      leaf.erase(leaf.find_last_not_of(" \t\r") + 1);
+      std::size_t slash = leaf.rfind('/');
+      if ( slash == std::string::npos || slash == 0 ||
+           slash + 2 != leaf.size() ) return false;
+
+      Column column;
+      column.name = leaf.substr(0, slash);
+      column.type = leaf[slash + 1];
+      int typeIndex = TypeIndex(column.type);
+      if ( typeIndex < 0 ) return false;
+      column.index = nofValues[typeIndex]++;
+      columns.push_back(column);
+    }
+    return ! columns.empty();
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  // returns the next whitespace delimited token of [p, end), zero
+  // terminated in place, or 0 at the end of the line
+  inline char* NextToken(char*& p, char* end)
+  {
+    while ( p < end && ( *p == ' ' || *p == '\t' || *p == '\r' ) ) ++p;
+    if ( p == end ) return 0;
+    char* token = p;
+    while ( p < end && *p != ' ' && *p != '\t' && *p != '\r' ) ++p;
+    *p = '\0';
+    if ( p < end ) ++p;
+    return token;
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  inline bool ParseInt(const char* token, const char* end, Int_t& value)
+  {
+#ifdef __cpp_lib_to_chars
+    std::from_chars_result result = std::from_chars(token, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    char* last;
+    value = std::strtol(token, &last, 10);
+    return last == end;
+#endif
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  inline bool ParseLong(const char* token, const char* end, Long64_t& value)
+  {
+#ifdef __cpp_lib_to_chars
+    std::from_chars_result result = std::from_chars(token, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    char* last;
+    value = std::strtoll(token, &last, 10);
+    return last == end;
+#endif
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  inline bool ParseDouble(const char* token, const char* end, Double_t& value)
+  {
+#ifdef __cpp_lib_to_chars
+    std::from_chars_result result = std::from_chars(token, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+#else
+    char* last;
+    value = std::strtod(token, &last);
+    return last == end;
+#endif
+  }
+
+  //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+  void Convert(Shard& shard, std::string& descriptor)
+  {
+    shard.ok = false;
+    shard.nofEntries = 0;
+    shard.nofBadLines = 0;
+
+    std::ifstream input(shard.input);
+    if ( ! input.is_open() ) {
+      std::cerr << "Cannot open " << shard.input << std::endl;
+      return;
+    }
+
+    std::vector<Column> columns;
+    if ( ! std::getline(input, descriptor) ||
+         ! ParseDescriptor(descriptor, columns) ) {
+      std::cerr << "No valid descriptor in " << shard.input << std::endl;
+      return;
+    }
+
+    // branch buffers of each type
+    std::size_t nofValues[4] = { 0, 0, 0, 0 };
+    for ( std::size_t i = 0; i < columns.size(); ++i ) {
+      ++nofValues[TypeIndex(columns[i].type)];
+    }
+    std::vector<Int_t>    ints(nofValues[0]);
+    std::vector<Long64_t> longs(nofValues[1]);
+    std::vector<Double_t> doubles(nofValues[2]);
+    std::vector<char>     strings(nofValues[3]*kMaxStringLength);
+
+    TFile* file = TFile::Open(shard.output.c_str(), "RECREATE", "",
+                              kCompression);
+    if ( ! file || file->IsZombie() ) {
+      std::cerr << "Cannot create " << shard.output << std::endl;
+      delete file;
+      return;
+    }
+    TTree* tree = new TTree("tree", "tree");
+    tree->SetDirectory(file);
+    for ( std::size_t i = 0; i < columns.size(); ++i ) {
+      const Column& column = columns[i];
+      void* address;
+      switch ( column.type ) {
+        case 'I': address = &ints[column.index]; break;
+        case 'L': address = &longs[column.index]; break;
+        case 'D': address = &doubles[column.index]; break;
+        default:  address = &strings[column.index*kMaxStringLength]; break;
+      }
+      std::string leaf = column.name + "/" + column.type;
+      tree->Branch(column.name.c_str(), address, leaf.c_str());
+    }
+
+    std::string line;
+    while ( std::getline(input, line) ) {
+      char* p = &line[0];
+      char* end = p + line.size();
+      bool ok = true;
+      std::size_t i = 0;
+      for ( ; i < columns.size() && ok; ++i ) {
+        char* token = NextToken(p, end);
+        if ( ! token ) break;
+        const char* tokenEnd = token + std::strlen(token);
+        const Column& column = columns[i];
+        switch ( column.type ) {
+          case 'I':
+            ok = ParseInt(token, tokenEnd, ints[column.index]);
+            break;
+          case 'L':
+            ok = ParseLong(token, tokenEnd, longs[column.index]);
+            break;
+          case 'D':
+            ok = ParseDouble(token, tokenEnd, doubles[column.index]);
+            break;
+          default:
+            {
+              char* value = &strings[column.index*kMaxStringLength];
+              std::strncpy(value, token, kMaxStringLength - 1);
+              value[kMaxStringLength - 1] = '\0';
+            }
+            break;
+        }
+      }
+      if ( i == 0 && ok ) continue;  // empty line
+      if ( ! ok || i < columns.size() || NextToken(p, end) ) {
+        ++shard.nofBadLines;
+        continue;
+      }
+      tree->Fill();
+      ++shard.nofEntries;
+    }
+
+    file->cd();
+    tree->Write();
+    // the tree is owned and deleted by the file
+    file->Close();
+    delete file;
+    shard.ok = true;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  std::string output = "run.root";
+  unsigned int nofThreads = std::thread::hardware_concurrency();
+  bool keepParts = false;
+  std::vector<std::string> inputs;
+
+  for ( int i = 1; i < argc; ++i ) {
+    std::string arg = argv[i];
+    if ( arg == "-o" && i + 1 < argc ) {
+      output = argv[++i];
+    }
+    else if ( arg == "-j" && i + 1 < argc ) {
+      nofThreads = std::atoi(argv[++i]);
+    }
+    else if ( arg == "-k" ) {
+      keepParts = true;
+    }
+    else if ( arg.size() > 1 && arg[0] == '-' ) {
+      std::cerr << "Usage: " << argv[0]
+                << " [-o run.root] [-j nofThreads] [-k] [file.dat ...]"
+                << std::endl;
+      return 1;
+    }
+    else {
+      inputs.push_back(arg);
+    }
+  }
+  if ( inputs.empty() ) inputs = FindInputs();
+  if ( inputs.empty() ) {
+    std::cerr << "No run_*.dat file found" << std::endl;
+    return 1;
+  }
+  if ( nofThreads < 1 ) nofThreads = 1;
+  if ( nofThreads > inputs.size() ) nofThreads = inputs.size();
+
+  // each thread writes its own files
+  ROOT::EnableThreadSafety();
+
+  std::string base = output;
+  if ( base.size() > 5 && base.compare(base.size() - 5, 5, ".root") == 0 ) {
+    base.erase(base.size() - 5);
+  }
+  std::vector<Shard> shards(inputs.size());
+  std::vector<std::string> descriptors(inputs.size());
+  for ( std::size_t i = 0; i < inputs.size(); ++i ) {
+    shards[i].input = inputs[i];
+    shards[i].output = base + "_" + std::to_string(i) + ".root";
+  }
+
+  // the files are distributed dynamically, as their sizes differ
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> threads;
+  for ( unsigned int t = 0; t < nofThreads; ++t ) {
+    threads.push_back(std::thread([&]() {
+      std::size_t i;
+      while ( ( i = next++ ) < shards.size() ) {
+        Convert(shards[i], descriptors[i]);
+      }
+    }));
+  }
+  for ( std::size_t t = 0; t < threads.size(); ++t ) threads[t].join();
+
+  bool ok = true;
+  Long64_t nofEntries = 0;
+  for ( std::size_t i = 0; i < shards.size(); ++i ) {
+    if ( ! shards[i].ok ) {
+      ok = false;
+      continue;
+    }
+    if ( descriptors[i] != descriptors[0] ) {
+      std::cerr << shards[i].input << " has other columns than "
+                << shards[0].input << std::endl;
+      ok = false;
+    }
+    if ( shards[i].nofBadLines > 0 ) {
+      std::cerr << shards[i].input << ": " << shards[i].nofBadLines
+                << " malformed lines skipped" << std::endl;
+    }
+    nofEntries += shards[i].nofEntries;
+  }
+
+  if ( ok ) {
+    TFileMerger merger(kFALSE);
+    ok = merger.OutputFile(output.c_str(), "RECREATE", kCompression);
+    for ( std::size_t i = 0; i < shards.size() && ok; ++i ) {
+      ok = merger.AddFile(shards[i].output.c_str(), kFALSE);
+    }
+    ok = ok && merger.Merge();
+  }
+
+  if ( ! keepParts || ! ok ) {
+    for ( std::size_t i = 0; i < shards.size(); ++i ) {
+      gSystem->Unlink(shards[i].output.c_str());
+    }
+  }
+  if ( ! ok ) {
+    std::cerr << "Conversion to " << output << " failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Converted " << inputs.size() << " files with "
+            << nofEntries << " steps into " << output << std::endl;
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -29,42 +29,156 @@
 
 #include "B1DetectorConstruction.hh"
 #include "B1ActionInitialization.hh"
+#include "B1EmPhysicsList.hh"
+#include "B1PhysicsTableCache.hh"
 
-#ifdef G4MULTITHREADED
+#include "G4RunManagerFactory.hh"
 #include "G4MTRunManager.hh"
-#else
-#include "G4RunManager.hh"
-#endif
 
 #include "G4UImanager.hh"
-#include "QBBC.hh"
+#include "G4StateManager.hh"
+#include "G4PhysListFactory.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
 
 #include "Randomize.hh"
 
+#ifdef B1_USE_ROOT
+#include "TROOT.h"
+#endif
+
+#include <cstdlib>
+
+namespace
+{
+  // "EmOnly" or the name of a Geant4 reference list, e.g. QBBC, FTFP_BERT
+  G4VModularPhysicsList* CreatePhysicsList(const G4String& name)
+  {
+    if ( name == "EmOnly" ) return new B1EmPhysicsList;
+
+    G4PhysListFactory factory;
+    G4VModularPhysicsList* physicsList = factory.GetReferencePhysList(name);
+    if ( ! physicsList ) {
+      G4ExceptionDescription msg;
+      msg << "Unknown physics list \"" << name << "\":" << G4endl;
+      msg << "use EmOnly or a Geant4 reference physics list.";
+      G4Exception("exampleB1", "MyCode0008", FatalException, msg);
+    }
+    return physicsList;
+  }
+
+  // Geant4 chooses the default one from $G4RUN_MANAGER_TYPE or the build
+  G4bool GetRunManagerType(const G4String& name, G4RunManagerType& type)
+  {
+    if      ( name == "default" ) type = G4RunManagerType::Default;
+    else if ( name == "serial"  ) type = G4RunManagerType::SerialOnly;
+    else if ( name == "mt"      ) type = G4RunManagerType::MTOnly;
+    else if ( name == "tasking" ) type = G4RunManagerType::TaskingOnly;
+    else return false;
+    return true;
+  }
+
+  // the engine of the master, whose type the workers' engines take
+  CLHEP::HepRandomEngine* CreateRandomEngine(const G4String& name)
+  {
+    if ( name == "ranecu" ) return new CLHEP::RanecuEngine;
+    if ( name == "mixmax" ) return new CLHEP::MixMaxRng;
+    return 0;
+  }
+
+  void PrintUsage()
+  {
+    G4cerr << "Usage: exampleB1 [-m] [macro] [-n nofEvents] [-t nofThreads]"
+           << G4endl
+           << "                 [-s seed] [-o outputDirectory] [-p physicsList]"
+           << G4endl
+           << "                 [-r serial|mt|tasking] [-e eventModulo]"
+           << " [-g ranecu|mixmax]" << G4endl
+           << " Without macro and nofEvents: interactive session with"
+           << " visualization." << G4endl
+           << " -n: /run/beamOn nofEvents after the macro, if any." << G4endl
+           << " -p: EmOnly or a Geant4 reference list (default $PHYSLIST"
+           << " or QBBC)." << G4endl
+           << " -r: run manager; with tasking, -e 1 dispatches the events one"
+           << " by one to the idle threads." << G4endl
+           << " -s: master seed of the per-event seeds; -g: random engine"
+           << " (default ranecu)." << G4endl;
+  }
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 int main(int argc,char** argv)
 {
-  // Detect interactive mode (if no arguments) and define UI session
+  // Command line options; without a macro and a number of events, an
+  // interactive session with visualization is started
+  //
+  G4String macro;
+  G4String physicsListName;
+  G4String outputDirectory;
+  G4int nofThreads = 0;
+  G4int nofEvents = 0;
+  G4int eventModulo = 0;
+  G4String seed;
+  G4String engineName = "ranecu";
+  G4RunManagerType runManagerType = G4RunManagerType::Default;
+  for ( G4int i = 1; i < argc; ++i ) {
+    G4String arg = argv[i];
+    G4bool hasValue = ( i + 1 < argc );
+    if      ( arg == "-m" && hasValue ) macro = argv[++i];
+    else if ( arg == "-p" && hasValue ) physicsListName = argv[++i];
+    else if ( arg == "-o" && hasValue ) outputDirectory = argv[++i];
+    else if ( arg == "-t" && hasValue ) nofThreads = std::atoi(argv[++i]);
+    else if ( arg == "-n" && hasValue ) nofEvents = std::atoi(argv[++i]);
+    else if ( arg == "-s" && hasValue ) seed = argv[++i];
+    else if ( arg == "-g" && hasValue ) engineName = argv[++i];
+    else if ( arg == "-e" && hasValue ) eventModulo = std::atoi(argv[++i]);
+    else if ( arg == "-r" && hasValue &&
+              GetRunManagerType(argv[i+1], runManagerType) ) ++i;
+    else if ( arg[0] != '-' && macro.empty() ) macro = arg;
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+  if ( physicsListName.empty() ) {
+    const char* envName = std::getenv("PHYSLIST");
+    physicsListName = envName ? envName : "QBBC";
+  }
+  CLHEP::HepRandomEngine* randomEngine = CreateRandomEngine(engineName);
+  if ( ! randomEngine ) {
+    PrintUsage();
+    return 1;
+  }
+  G4bool interactive = ( macro.empty() && nofEvents == 0 );
+
+  // Define UI session, in interactive mode only
   //
   G4UIExecutive* ui = 0;
-  if ( argc == 1 ) {
+  if ( interactive ) {
     ui = new G4UIExecutive(argc, argv);
   }
 
-  // Choose the Random engine
-  G4Random::setTheEngine(new CLHEP::RanecuEngine);
+#if defined(G4MULTITHREADED) && defined(B1_USE_ROOT)
+  // Workers write their own ROOT files concurrently
+  ROOT::EnableThreadSafety();
+#endif
+
+  // Choose the Random engine, before the run manager; each event
+  // reseeds it from the master seed (see B1RandomSeeds)
+  G4Random::setTheEngine(randomEngine);
   
-  // Construct the default run manager
+  // Construct the run manager: serial, multi-threaded or task-based
   //
-#ifdef G4MULTITHREADED
-  G4MTRunManager* runManager = new G4MTRunManager;
-#else
-  G4RunManager* runManager = new G4RunManager;
-#endif
+  G4RunManager* runManager
+    = G4RunManagerFactory::CreateRunManager(runManagerType);
+  if ( nofThreads > 0 ) runManager->SetNumberOfThreads(nofThreads);
+  // the number of events per dispatch to a thread, MT and tasking only
+  G4MTRunManager* mtRunManager = G4RunManagerFactory::GetMTMasterRunManager();
+  if ( eventModulo > 0 && mtRunManager ) mtRunManager->SetEventModulo(eventModulo);
 
   // Set mandatory initialization classes
   //
@@ -72,33 +186,63 @@ int main(int argc,char** argv)
   runManager->SetUserInitialization(new B1DetectorConstruction());
 
   // Physics list
-  G4VModularPhysicsList* physicsList = new QBBC;
+  G4VModularPhysicsList* physicsList = CreatePhysicsList(physicsListName);
   physicsList->SetVerboseLevel(1);
+  // applies the step limits of the detector regions
+  physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+  // the vacuum transport model of the envelope, for the charged particles
+  G4FastSimulationPhysics* fastSimulationPhysics = new G4FastSimulationPhysics();
+  const char* chargedParticles[] = {
+    "e-", "e+", "mu-", "mu+", "pi-", "pi+", "proton", "anti_proton",
+    "deuteron", "triton", "He3", "alpha", "GenericIon"
+  };
+  for ( std::size_t i = 0; i < sizeof(chargedParticles)/sizeof(chargedParticles[0]); ++i ) {
+    fastSimulationPhysics->ActivateFastSimulation(chargedParticles[i]);
+  }
+  physicsList->RegisterPhysics(fastSimulationPhysics);
   runManager->SetUserInitialization(physicsList);
+
+  // retrieves the physics tables stored by a previous job, if any
+  B1PhysicsTableCache* tableCache
+    = new B1PhysicsTableCache(physicsList, physicsListName);
     
   // User action initialization
   runManager->SetUserInitialization(new B1ActionInitialization());
   
-  // Initialize visualization
-  //
-  G4VisManager* visManager = new G4VisExecutive;
-  // G4VisExecutive can take a verbosity argument - see /vis/verbose guidance.
-  // G4VisManager* visManager = new G4VisExecutive("Quiet");
-  visManager->Initialize();
-
   // Get the pointer to the User Interface manager
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
+  if ( ! seed.empty() ) {
+    UImanager->ApplyCommand("/B1/random/masterSeed " + seed);
+  }
 
   // Process macro or start UI session
   //
-  if ( ! ui ) { 
-    // batch mode
-    G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command+fileName);
+  G4VisManager* visManager = 0;
+  if ( ! interactive ) {
+    // batch mode, without visualization
+    if ( ! outputDirectory.empty() ) {
+      UImanager->ApplyCommand("/B1/output/directory " + outputDirectory);
+    }
+    if ( ! macro.empty() ) {
+      UImanager->ApplyCommand("/control/execute " + macro);
+    }
+    if ( nofEvents > 0 ) {
+      if ( G4StateManager::GetStateManager()->GetCurrentState()
+           == G4State_PreInit ) {
+        UImanager->ApplyCommand("/run/initialize");
+      }
+      UImanager->ApplyCommand("/run/beamOn " + std::to_string(nofEvents));
+    }
   }
   else { 
     // interactive mode
+    visManager = new G4VisExecutive;
+    // G4VisExecutive can take a verbosity argument - see /vis/verbose guidance.
+    // G4VisManager* visManager = new G4VisExecutive("Quiet");
+    visManager->Initialize();
+    if ( ! outputDirectory.empty() ) {
+      UImanager->ApplyCommand("/B1/output/directory " + outputDirectory);
+    }
     UImanager->ApplyCommand("/control/execute init_vis.mac");
     ui->SessionStart();
     delete ui;
@@ -110,6 +254,7 @@ int main(int argc,char** argv)
   // in the main() program !
   
   delete visManager;
+  delete tableCache;
   delete runManager;
 }
 
@@ -0,0 +1,81 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1BinaryStepWriter.hh
+/// \brief Definition of the B1BinaryStepWriter class
+
+#ifndef B1BinaryStepWriter_h
+#define B1BinaryStepWriter_h 1
+
+#include "B1StepWriter.hh"
+
+#include <fstream>
+
+/// Writer of the binary column-blocked format.
+///
+/// The file starts with a self-describing header:
+///   char[8]  magic "B1STEPS"
+///   uint32   format version
+///   uint32   byte order mark 0x01020304 (written in native order)
+///   uint32   number of columns
+///   per column:
+///     char   type ('I' int32, 'D' float64, 'C' fixed width string)
+///     uint8  width of one value in bytes
+///     uint8  name length, followed by the name
+///     uint8  unit length, followed by the unit
+/// The columns are those of the B1StepSchema of the writer.
+/// The header is followed by blocks of records. Each block is a uint32 row count
+/// followed by the values of every column stored contiguously, column
+/// after column, in the order of the header.
+
+class B1BinaryStepWriter : public B1StepWriter
+{
+  public:
+    B1BinaryStepWriter(const B1StepSchema& schema);
+    virtual ~B1BinaryStepWriter();
+
+    virtual G4bool Open(const G4String& fileName);
+    virtual void   WriteBlock(const std::vector<B1StepRecord>& records,
+                              std::size_t nofRecords);
+    virtual void   Close();
+
+    virtual G4String GetExtension() const { return ".bin"; }
+    virtual G4bool   SkipHeader(std::istream& input) const;
+
+    static const G4int kVersion = 1;
+
+  private:
+    void WriteHeader();
+    template <typename T>
+    void Put(const T& value);
+
+    std::ofstream     fFile;
+    std::vector<char> fBuffer;  // reused between blocks
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
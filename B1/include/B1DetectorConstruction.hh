@@ -33,28 +33,110 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 
+#include <map>
+#include <vector>
+
 class G4VPhysicalVolume;
 class G4LogicalVolume;
-class G4UserLimits;
+class G4Material;
+class G4Region;
+class G4ProductionCuts;
+class B1DetectorMessenger;
 
 /// Detector construction class to define materials and geometry.
+///
+/// The detector is a stack of layers (by default the Al and Ta foils) in
+/// the envelope, described by a layer file (/B1/det/layers) or set layer
+/// by layer with the /B1/det/ commands; in the Idle state, a change
+/// rebuilds the geometry at the next run while keeping the physics.
+/// The scoring volume IDs are 1 to N for the layers, in beam order, and
+/// N+1 for the envelope (0 is the world).
+///
+/// A layer can be sliced along z in a given number of replicas
+/// (/B1/det/slices), when the steps must stop at the slice boundaries;
+/// otherwise its depth profile is scored without slices, in nofDepthBins
+/// (/B1/det/depthBins or /B1/histo/depth).
+///
+/// Each layer is the root of its own region, "Layer<ID>", with its own
+/// production cut and maximum step length, and the envelope of the
+/// region "Envelope"; without a cut of their own (/B1/det/cut and
+/// /B1/det/envelopeCut), they keep the cuts of the world, the default
+/// region, which are set with /run/setCut. The step
+/// limits require the G4StepLimiterPhysics of the physics list.
+///
+/// While the envelope is lighter than the vacuum density threshold
+/// (/B1/det/vacuumDensity), the charged particles cross it in one step
+/// with the B1VacuumTransportModel fast simulation, built per thread in
+/// ConstructSDandField().
 
 class B1DetectorConstruction : public G4VUserDetectorConstruction
 {
   public:
+    struct Layer {
+      G4String    name;
+      G4Material* material;
+      G4double    thickness;
+      G4double    gap;           // before the layer, see Construct()
+      G4int       nofSlices;     // 1 = no slicing
+      G4int       nofDepthBins;  // 0 = no depth profile
+      G4double    cut;           // 0 = the default cuts
+      G4double    maxStep;       // 0 = no step limit
+    };
+
     B1DetectorConstruction();
     virtual ~B1DetectorConstruction();
 
     virtual G4VPhysicalVolume* Construct();
+    virtual void ConstructSDandField();
     
-    G4LogicalVolume* GetScoringVolumeInitial() const { return fScoringVolumeInitial; }
-    G4LogicalVolume* GetScoringVolumeStop() const { return fScoringVolumeStop; }
+    G4LogicalVolume* GetScoringVolumeEnv() const { return fScoringVolumeEnv; }
+    // layerID = 1 to GetNofLayers(), as the scoring volume ID
+    G4int GetNofLayers() const { return fLayers.size(); }
+    const Layer& GetLayer(G4int layerID) const { return fLayers[layerID-1]; }
+    G4LogicalVolume* GetLayerVolume(G4int layerID) const
+      { return fLayerVolumes[layerID-1]; }
+
+    // replaces all the layers; returns false and keeps them on error
+    G4bool ReadLayers(const G4String& fileName);
+    void SetThickness(G4int layerID, G4double thickness);
+    void SetGap(G4int layerID, G4double gap);
+    void SetNofSlices(G4int layerID, G4int nofSlices);
+    void SetNofDepthBins(G4int layerID, G4int nofBins);
+    void SetMaterial(G4int layerID, const G4String& materialName);
+    void SetEnvelopeMaterial(const G4String& materialName);
+    // the regions are updated without rebuilding the geometry
+    void SetCut(G4int layerID, G4double cut);
+    void SetMaxStep(G4int layerID, G4double maxStep);
+    void SetEnvelopeCut(G4double cut);
+    void SetEnvelopeMaxStep(G4double maxStep);
+    // 0 = no fast vacuum transport; read by the model at each track
+    void SetVacuumDensity(G4double density) { fVacuumDensity = density; }
+    G4double GetVacuumDensity() const { return fVacuumDensity; }
 
   protected:
-    G4LogicalVolume*  fScoringVolumeInitial;
-    G4LogicalVolume*  fScoringVolumeStop;
+    G4LogicalVolume*  fScoringVolumeEnv;
+
+  private:
+    void DefineMaterials();
+    G4Material* FindMaterial(const G4String& materialName) const;
+    G4bool CheckLayer(G4int layerID) const;
+    void SliceFoil(G4LogicalVolume* foil, G4int nofSlices) const;
+    void SetUpRegions(G4LogicalVolume* envelope) const;
+    void ApplyRegionSettings() const;
+    void SetRegionCuts(G4Region* region, G4double cut, G4double maxStep) const;
+    void PhysicsHasBeenModified();
+    void ReinitializeGeometry();
 
-    G4UserLimits*     fStepLimit;       // pointer to user step limits
+    G4Material*           fVacuum;
+    G4Material*           fEnvMaterial;
+    G4double              fEnvCut;
+    G4double              fEnvMaxStep;
+    G4double              fVacuumDensity;
+    std::vector<Layer>    fLayers;
+    std::vector<G4LogicalVolume*> fLayerVolumes;  // as fLayers
+    // the own cuts of the regions, by region name
+    mutable std::map<G4String, G4ProductionCuts*> fRegionCuts;
+    B1DetectorMessenger*  fMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,69 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1DoseAccumulable.hh
+/// \brief Definition of the B1DoseAccumulable class
+
+#ifndef B1DoseAccumulable_h
+#define B1DoseAccumulable_h 1
+
+#include "B1StepContext.hh"
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+/// Accumulable of the energy deposit per volume ID and of its square,
+/// summed over the events.
+///
+/// Each thread fills its own instance at the end of event, without any
+/// lock; the G4AccumulableManager merges the workers' instances into the
+/// master one in B1RunAction::EndOfRunAction().
+
+class B1DoseAccumulable : public G4VAccumulable
+{
+  public:
+    static const G4int kMaxNofVolumes = B1StepContext::kMaxNofVolumes;
+
+    B1DoseAccumulable(const G4String& name);
+    virtual ~B1DoseAccumulable();
+
+    // adds the per-volume energy deposit of one event
+    void AddEvent(const G4double edep[kMaxNofVolumes]);
+
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    G4double GetEdep(G4int volumeID) const { return fEdep[volumeID]; }
+    G4double GetEdep2(G4int volumeID) const { return fEdep2[volumeID]; }
+
+  private:
+    G4double fEdep[kMaxNofVolumes];
+    G4double fEdep2[kMaxNofVolumes];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -30,15 +30,21 @@
 #ifndef B1EventAction_h
 #define B1EventAction_h 1
 
+#include "B1EventSummary.hh"
+
 #include "G4UserEventAction.hh"
 #include "globals.hh"
 
 #include <fstream>
 
 class B1RunAction;
+class G4Step;
 
 /// Event action class
 ///
+/// In the events output mode, it accumulates the B1EventSummary of the
+/// event from the steps passed via AddStep() and writes it at the end
+/// of event.
 
 class B1EventAction : public G4UserEventAction
 {
@@ -49,15 +55,17 @@ class B1EventAction : public G4UserEventAction
     virtual void BeginOfEventAction(const G4Event* event);
     virtual void EndOfEventAction(const G4Event* event);
 
-    void AddEdep(G4double edep) { fEdep += edep; }
+    void AddEdep(G4int volumeID, G4double edep) { fEdep[volumeID] += edep; }
+    void AddStep(const G4Step* step, G4int volumeID);
 
-    G4double GetEdep() { return fEdep; }
+    G4double GetEdep(G4int volumeID) { return fEdep[volumeID]; }
 
     std::ofstream ofile;
 
   private:
-    B1RunAction* fRunAction;
-    G4double     fEdep;
+    B1RunAction*   fRunAction;
+    G4double       fEdep[B1StepContext::kMaxNofVolumes];
+    B1EventSummary fSummary;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventOutput.hh
+/// \brief Definition of the B1EventOutput class
+
+#ifndef B1EventOutput_h
+#define B1EventOutput_h 1
+
+#include "B1EventSummary.hh"
+#include "globals.hh"
+
+#include <fstream>
+
+/// Writer of the event summaries, one line per event in events_<runID>.dat,
+/// with a TTree::ReadFile descriptor as the first line, as the text step
+/// output (see B1EventSummary for the columns).
+///
+/// In multi-threading mode each worker writes events_r<runID>_t<threadID>.dat
+/// and the master concatenates them into events_<runID>.dat at the end of
+/// run, unless the merging is switched off via /B1/output/merge.
+
+class B1EventOutput
+{
+  public:
+    B1EventOutput();
+    ~B1EventOutput();
+
+    // the directory is empty or ends with a slash
+    void BeginOfRun(G4int runID, const G4String& directory);
+    void EndOfRun(G4bool merge);
+
+    void Write(const B1EventSummary& summary);
+
+  private:
+    // the volume columns are those of the first summary
+    void     Open(const B1EventSummary& summary);
+    void     Close();
+    void     Merge();
+    G4String GetShardName(G4int threadID) const;
+
+    std::ofstream fFile;
+    G4int         fRunID;
+    G4String      fDirectory;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventSummary.hh
+/// \brief Definition of the B1EventSummary structure
+
+#ifndef B1EventSummary_h
+#define B1EventSummary_h 1
+
+#include "B1StepContext.hh"
+
+#include "globals.hh"
+
+/// Summary of one event, accumulated by B1EventAction from the steps and
+/// written instead of (or with) the steps in the events output mode.
+///
+/// The arrays are indexed by the volume ID of the stepping action
+/// (world = 0, layers = 1 to N, envelope = N+1), of which nofVolumes
+/// are used and written. The entry and exit
+/// energies are those of the primary particle when it first enters and
+/// last leaves a volume, 0 if it never did; the stop position is the
+/// end of the primary track, in the volume stopVolume, or -1 if it left
+/// the world. The values are in keV and um, as in the step output.
+/// The event seed (see B1RandomSeeds) regenerates the event.
+
+struct B1EventSummary
+{
+  static const G4int kMaxNofVolumes = B1StepContext::kMaxNofVolumes;
+
+  G4int    eventID;
+  G4long   eventSeed;
+  G4int    nofVolumes;
+  G4double edep[kMaxNofVolumes];          // keV, all particles
+  G4int    nofSteps[kMaxNofVolumes];      // all particles
+  G4double entryEnergy[kMaxNofVolumes];   // keV, primary
+  G4double exitEnergy[kMaxNofVolumes];    // keV, primary
+  G4int    stopVolume;
+  G4double stopX;                      // um
+  G4double stopY;                      // um
+  G4double stopZ;                      // um
+
+  void Reset(G4int id, G4int nVolumes)
+  {
+    eventID = id;
+    eventSeed = 0;
+    nofVolumes = nVolumes;
+    for ( G4int i = 0; i < kMaxNofVolumes; ++i ) {
+      edep[i] = 0.;
+      nofSteps[i] = 0;
+      entryEnergy[i] = 0.;
+      exitEnergy[i] = 0.;
+    }
+    stopVolume = -1;
+    stopX = stopY = stopZ = 0.;
+  }
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
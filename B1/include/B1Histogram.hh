@@ -0,0 +1,127 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Histogram.hh
+/// \brief Definition of the B1Histogram class
+
+#ifndef B1Histogram_h
+#define B1Histogram_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+/// Fixed-bin 1D or 2D histogram with the sums of weights and of squared
+/// weights per bin, including the underflow and overflow bins, with the
+/// bin numbering of ROOT (0 underflow, 1..n, n+1 overflow).
+///
+/// It is a plain container: filled by a single thread and added to
+/// another one by B1HistogramSet::Merge().
+
+class B1Histogram
+{
+  public:
+    B1Histogram(const G4String& name, const G4String& title,
+                G4int nx, G4double xmin, G4double xmax);
+    B1Histogram(const G4String& name, const G4String& title,
+                G4int nx, G4double xmin, G4double xmax,
+                G4int ny, G4double ymin, G4double ymax);
+
+    inline void Fill(G4double x, G4double weight);
+    inline void Fill(G4double x, G4double y, G4double weight);
+    // 1D only: spreads the weight uniformly over [x1, x2]
+    void FillRange(G4double x1, G4double x2, G4double weight);
+
+    void Add(const B1Histogram& other);
+    void Reset();
+
+    const G4String& GetName() const { return fName; }
+    const G4String& GetTitle() const { return fTitle; }
+    G4int    GetDimension() const { return fNy > 0 ? 2 : 1; }
+    G4int    GetNbinsX() const { return fNx; }
+    G4double GetXmin() const { return fXmin; }
+    G4double GetXmax() const { return fXmax; }
+    G4int    GetNbinsY() const { return fNy; }
+    G4double GetYmin() const { return fYmin; }
+    G4double GetYmax() const { return fYmax; }
+    G4double GetEntries() const { return fEntries; }
+
+    G4double GetBinContent(G4int ix, G4int iy = 0) const
+      { return fSumW[ix + (fNx+2)*iy]; }
+    G4double GetBinError2(G4int ix, G4int iy = 0) const
+      { return fSumW2[ix + (fNx+2)*iy]; }
+
+  private:
+    static inline G4int FindBin(G4double value, G4int n,
+                                G4double min, G4double max);
+
+    G4String fName;
+    G4String fTitle;
+    G4int    fNx;
+    G4double fXmin;
+    G4double fXmax;
+    G4int    fNy;             // 0 for a 1D histogram
+    G4double fYmin;
+    G4double fYmax;
+    G4double fEntries;
+    std::vector<G4double> fSumW;
+    std::vector<G4double> fSumW2;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int B1Histogram::FindBin(G4double value, G4int n,
+                                  G4double min, G4double max)
+{
+  if ( value < min ) return 0;
+  if ( value >= max ) return n+1;
+  return 1 + G4int(n*(value - min)/(max - min));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1Histogram::Fill(G4double x, G4double weight)
+{
+  G4int bin = FindBin(x, fNx, fXmin, fXmax);
+  fSumW[bin]  += weight;
+  fSumW2[bin] += weight*weight;
+  fEntries += 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void B1Histogram::Fill(G4double x, G4double y, G4double weight)
+{
+  G4int bin = FindBin(x, fNx, fXmin, fXmax)
+            + (fNx+2)*FindBin(y, fNy, fYmin, fYmax);
+  fSumW[bin]  += weight;
+  fSumW2[bin] += weight*weight;
+  fEntries += 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
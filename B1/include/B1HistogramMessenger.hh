@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HistogramMessenger.hh
+/// \brief Definition of the B1HistogramMessenger class
+
+#ifndef B1HistogramMessenger_h
+#define B1HistogramMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1HistogramSet;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithoutParameter;
+
+/// Messenger class that defines commands for B1HistogramSet.
+///
+/// It implements commands:
+/// - /B1/histo/add1D name x nbins min max [edep|count] [volumeID]
+/// - /B1/histo/add2D name x y nx xmin xmax ny ymin ymax [edep|count] [volumeID]
+/// - /B1/histo/depth volumeID nbins [min max unit]
+/// - /B1/histo/format root|csv
+/// - /B1/histo/clear
+
+class B1HistogramMessenger: public G4UImessenger
+{
+  public:
+    B1HistogramMessenger(B1HistogramSet* histograms);
+    virtual ~B1HistogramMessenger();
+    
+    virtual void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+    B1HistogramSet*            fHistograms;
+
+    G4UIdirectory*             fHistoDirectory;
+    G4UIcommand*               fAdd1DCmd;
+    G4UIcommand*               fAdd2DCmd;
+    G4UIcommand*               fDepthCmd;
+    G4UIcmdWithAString*        fFormatCmd;
+    G4UIcmdWithoutParameter*   fClearCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,142 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HistogramSet.hh
+/// \brief Definition of the B1HistogramSet class
+
+#ifndef B1HistogramSet_h
+#define B1HistogramSet_h 1
+
+#include "B1Histogram.hh"
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Step;
+class B1StepContext;
+class B1HistogramMessenger;
+
+/// Accumulable of the step histograms booked with the /B1/histo/ commands.
+///
+/// A histogram bins one step quantity (1D) or two (2D), weighted with the
+/// energy deposit or with 1, optionally only in one volume ID. The
+/// quantities are taken in the units of the step output (um, keV, ns).
+/// Each thread fills its own instance from the stepping action, without
+/// any lock; the G4AccumulableManager merges the workers' instances into
+/// the master one, which writes them in histos_<runID>.root (TH1D, TH2D)
+/// or in histos_<runID>_<name>.csv files.
+///
+/// A depth profile, "depth_<volumeID>", bins the energy deposit by the
+/// local z in a volume: the deposit of a step is spread uniformly between
+/// its pre- and post-step local z, so the bins need no geometry slices and
+/// the steps are not limited by them. By default the bins cover the full
+/// thickness of the volume, taken from its solid in BeginOfRun(). The
+/// layers with depth bins (/B1/det/depthBins) get such a profile at each
+/// run, unless one is booked for them with /B1/histo/depth.
+
+class B1HistogramSet : public G4VAccumulable
+{
+  public:
+    enum Quantity {
+      kX, kY, kZ,             // post-step position
+      kLocalZ,                // post-step z in the scoring volume frame
+      kKinEnergy,
+      kEdep,
+      kStepLength,
+      kTime,
+      kNofQuantities
+    };
+
+    B1HistogramSet(const G4String& name);
+    virtual ~B1HistogramSet();
+
+    // the quantity of a key (x y z localz ke edep steplen time)
+    static G4bool GetQuantity(const G4String& key, Quantity& quantity);
+
+    void Add1D(const G4String& name, Quantity x,
+               G4int nx, G4double xmin, G4double xmax,
+               G4bool edepWeight, G4int volumeID);
+    void Add2D(const G4String& name, Quantity x, Quantity y,
+               G4int nx, G4double xmin, G4double xmax,
+               G4int ny, G4double ymin, G4double ymax,
+               G4bool edepWeight, G4int volumeID);
+    // nbins = 0 removes the profile, min = max selects the full thickness
+    void SetDepthBinning(G4int volumeID, G4int nbins,
+                         G4double min, G4double max);
+    void Clear();
+    void SetFormat(const G4String& format) { fFormat = format; }
+
+    // resolves the depth ranges from the current geometry
+    void BeginOfRun(const B1StepContext& context);
+    void Fill(const G4Step* step, G4int volumeID);
+
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    // on master, after the merge
+    // the directory is empty or ends with a slash
+    void Write(G4int runID, const G4String& directory) const;
+
+    std::size_t GetNofHistograms() const { return fHistograms.size(); }
+    const B1Histogram& GetHistogram(std::size_t i) const
+      { return fHistograms[i]; }
+
+  private:
+    struct Binning {
+      Quantity x;
+      Quantity y;             // = x for a 1D histogram
+      G4bool   edepWeight;
+      G4int    volumeID;      // -1 for all the volumes
+      G4bool   depth;         // edep spread between pre- and post-step z
+      G4bool   fullDepth;     // range = volume thickness
+      G4bool   fromLayer;     // booked from the layer depth bins
+    };
+
+    G4bool CanAdd(const G4String& name) const;
+    void UpdateQuantities();
+    void AddDepthBinning(G4int volumeID, G4int nbins,
+                         G4double min, G4double max, G4bool fromLayer);
+    G4String GetTitle(Quantity x, Quantity y, G4bool is2D,
+                      G4bool edepWeight, G4int volumeID) const;
+    void WriteCsv(G4int runID, const G4String& directory) const;
+#ifdef B1_USE_ROOT
+    void WriteRoot(G4int runID, const G4String& directory) const;
+#endif
+
+    B1HistogramMessenger*    fMessenger;
+    const B1StepContext*     fStepContext;
+    std::vector<B1Histogram> fHistograms;
+    std::vector<Binning>     fBinnings;   // indexed as fHistograms
+    G4int                    fQuantities; // bit mask of the filled quantities
+    G4bool                   fHasDepth;
+    G4String                 fFormat;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1OutputMessenger.hh
+/// \brief Definition of the B1OutputMessenger class
+
+#ifndef B1OutputMessenger_h
+#define B1OutputMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1StepOutput;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+
+/// Messenger class that defines commands for B1StepOutput.
+///
+/// It implements commands:
+/// - /B1/output/mode steps|events|both
+/// - /B1/output/format text|binary|root
+/// - /B1/output/columns key1,key2,...
+/// - /B1/output/blockSize n
+/// - /B1/output/merge true|false
+/// - /B1/output/async true|false
+/// - /B1/output/nofBuffers n
+/// - /B1/output/maxEventsPerFile n
+/// - /B1/output/maxFileSize MB
+/// - /B1/output/maxFileTime value unit
+/// - /B1/output/index true|false
+/// - /B1/output/directory path
+
+class B1OutputMessenger: public G4UImessenger
+{
+  public:
+    B1OutputMessenger(B1StepOutput* output);
+    virtual ~B1OutputMessenger();
+    
+    virtual void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+    B1StepOutput*         fStepOutput;
+
+    G4UIdirectory*        fOutputDirectory;
+    G4UIcmdWithAString*   fModeCmd;
+    G4UIcmdWithAString*   fFormatCmd;
+    G4UIcmdWithAString*   fColumnsCmd;
+    G4UIcmdWithAnInteger* fBlockSizeCmd;
+    G4UIcmdWithABool*     fMergeCmd;
+    G4UIcmdWithABool*     fAsyncCmd;
+    G4UIcmdWithAnInteger* fNofBuffersCmd;
+    G4UIcmdWithAnInteger* fMaxEventsCmd;
+    G4UIcmdWithADouble*   fMaxSizeCmd;
+    G4UIcmdWithADoubleAndUnit* fMaxTimeCmd;
+    G4UIcmdWithABool*     fIndexCmd;
+    G4UIcmdWithAString*   fDirectoryCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
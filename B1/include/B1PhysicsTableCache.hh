@@ -0,0 +1,86 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhysicsTableCache.hh
+/// \brief Definition of the B1PhysicsTableCache class
+
+#ifndef B1PhysicsTableCache_h
+#define B1PhysicsTableCache_h 1
+
+#include "G4VStateDependent.hh"
+#include "globals.hh"
+
+class G4VUserPhysicsList;
+class B1PhysicsTableCacheMessenger;
+
+/// Cache of the physics tables, shared by the jobs started in the same
+/// directory.
+///
+/// At the first run initialization, before the tables are built, the
+/// physics list name, the Geant4 version, the materials and the
+/// production cuts of all the regions are hashed into a key. If the cache
+/// directory has tables for this key, the physics list retrieves them;
+/// otherwise they are built as usual and stored once the run is
+/// initialized, in <cacheDirectory>/<key>. The tables are first written
+/// in a directory private to the process, then renamed, so that
+/// concurrent jobs never read incomplete tables.
+///
+/// The cache directory is set with /B1/phys/tableCache, or initially
+/// from $B1_PHYSICS_CACHE (default "physics_tables"); "none" disables
+/// it. The EM parameters changed with /process/em/ are not in the key:
+/// disable the cache, or change its directory, when changing them.
+
+class B1PhysicsTableCache : public G4VStateDependent
+{
+  public:
+    B1PhysicsTableCache(G4VUserPhysicsList* physicsList,
+                        const G4String& physicsListName);
+    virtual ~B1PhysicsTableCache();
+
+    // method from the base class
+    virtual G4bool Notify(G4ApplicationState requestedState);
+
+    // empty = no cache
+    void SetDirectory(const G4String& directory) { fDirectory = directory; }
+
+  private:
+    G4String GetDescription() const;
+    void BeginOfRunInitialization();
+    void EndOfRunInitialization();
+
+    G4VUserPhysicsList*           fPhysicsList;
+    G4String                      fPhysicsListName;
+    G4String                      fDirectory;
+    G4String                      fKeyDirectory;   // of the current tables
+    G4String                      fDescription;
+    G4bool                        fIsDone;
+    G4bool                        fToBeStored;
+    B1PhysicsTableCacheMessenger* fMessenger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -36,17 +36,19 @@
 
 class G4ParticleGun;
 class G4Event;
-class G4Box;
+class B1RandomSeeds;
 
 /// The primary generator action class with particle gun.
 ///
-/// The default kinematic is a 6 MeV gamma, randomly distribued 
-/// in front of the phantom across 80% of the (X,Y) phantom size.
+/// The default kinematic is a 1 MeV alpha along z, randomly distributed
+/// over a 1 cm x 1 cm square at z = -15 cm, in front of the foils.
+/// The random engine is reseeded with the event seed before the
+/// primaries are generated.
 
 class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    B1PrimaryGeneratorAction();    
+    B1PrimaryGeneratorAction(B1RandomSeeds* randomSeeds);
     virtual ~B1PrimaryGeneratorAction();
 
     // method from the base class
@@ -57,7 +59,7 @@ class B1PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
   
   private:
     G4ParticleGun*  fParticleGun; // pointer a to G4 gun class
-    G4Box* fEnvelopeBox;
+    B1RandomSeeds* fRandomSeeds;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RandomSeeds.hh
+/// \brief Definition of the B1RandomSeeds class
+
+#ifndef B1RandomSeeds_h
+#define B1RandomSeeds_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class B1RandomSeedsMessenger;
+
+/// Per-event seeding of the random engine of each thread.
+///
+/// Before its primaries are generated, each event reseeds the engine of
+/// its thread with an event seed derived only from the master seed
+/// (/B1/random/masterSeed, or the -s option of exampleB1), the run ID and
+/// the event ID. An event is thus the same in a serial, multi-threaded or
+/// task-based run, whichever thread processes it, and its seed, written
+/// in the event summaries, is enough to regenerate it: the seeds given to
+/// /B1/random/replay are used instead, in order, by the events of the
+/// next run.
+///
+/// The engine itself, Ranecu or MixMax, is chosen in exampleB1; the
+/// workers create their engines of the type of the master one.
+
+class B1RandomSeeds
+{
+  public:
+    B1RandomSeeds();
+    ~B1RandomSeeds();
+
+    void SetMasterSeed(G4long seed) { fMasterSeed = seed; }
+    void SetReplaySeeds(const std::vector<G4long>& seeds);
+
+    G4long GetMasterSeed() const { return fMasterSeed; }
+    G4long GetEventSeed() const { return fEventSeed; }
+
+    void BeginOfRun(G4int runID, G4bool isMaster);
+    // reseeds the engine of this thread, before the primaries are generated
+    void BeginOfEvent(G4int eventID);
+    void EndOfRun();
+
+    // the non-negative event seed, a 62-bit hash of the three IDs
+    static G4long EventSeed(G4long masterSeed, G4int runID, G4int eventID);
+
+  private:
+    B1RandomSeedsMessenger* fMessenger;
+    G4long                  fMasterSeed;
+    G4int                   fRunID;
+    G4long                  fEventSeed;
+    std::vector<G4long>     fReplaySeeds;     // by event ID of the next run
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
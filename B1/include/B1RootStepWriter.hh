@@ -0,0 +1,78 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RootStepWriter.hh
+/// \brief Definition of the B1RootStepWriter class
+
+#ifndef B1RootStepWriter_h
+#define B1RootStepWriter_h 1
+
+#ifdef B1_USE_ROOT
+
+#include "B1StepWriter.hh"
+
+class TFile;
+class TTree;
+
+/// Writer of a ROOT file with the steps in a TTree "tree".
+///
+/// The branches are the fields of the schema of the writer, with the
+/// names and types of the text format descriptor,
+/// so the tree is the same as the one CreateRunFile.C builds with
+/// TTree::ReadFile from the text files. The shards of the workers are
+/// merged with TFileMerger, which copies the compressed baskets.
+
+class B1RootStepWriter : public B1StepWriter
+{
+  public:
+    B1RootStepWriter(const B1StepSchema& schema);
+    virtual ~B1RootStepWriter();
+
+    virtual G4bool Open(const G4String& fileName);
+    virtual void   WriteBlock(const std::vector<B1StepRecord>& records,
+                              std::size_t nofRecords);
+    virtual void   Close();
+
+    virtual G4String GetExtension() const { return ".root"; }
+    virtual G4bool   SkipHeader(std::istream& input) const;
+    virtual G4bool   MergeFiles(const std::vector<G4String>& inputs,
+                                const G4String& output,
+                                std::vector<G4long>& offsetShifts) const;
+
+    // LZ4, level 4
+    static const G4int kCompression = 404;
+
+  private:
+    TFile*       fFile;
+    TTree*       fTree;
+    B1StepRecord fRecord;  // branch buffers
+};
+
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
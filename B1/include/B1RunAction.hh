@@ -30,17 +30,32 @@
 #ifndef B1RunAction_h
 #define B1RunAction_h 1
 
+#include "B1DoseAccumulable.hh"
+#include "B1HistogramSet.hh"
+#include "B1ThreadStatistics.hh"
+
 #include "G4UserRunAction.hh"
-#include "G4Accumulable.hh"
 #include "globals.hh"
 
+#include <chrono>
+
 class G4Run;
+class B1StepContext;
+class B1StepOutput;
+class B1TrackKiller;
+class B1RandomSeeds;
 
 /// Run action class
 ///
-/// In EndOfRunAction(), it calculates the dose in the selected volume 
-/// from the energy deposit accumulated via stepping and event actions.
-/// The computed dose is then printed on the screen.
+/// In EndOfRunAction(), it calculates the dose in each scoring volume
+/// from the energy deposit accumulated per volume via stepping and event
+/// actions. The computed doses are then printed on the screen, and the
+/// step histograms, merged on master, are written to files.
+/// It also owns the step output, so that its UI commands are available
+/// both on master and on workers, the per-thread step context and the
+/// track killer of the region of interest, whose counters are printed
+/// with the doses, as are the events processed by each worker thread,
+/// and the per-event seeding of the random engine of the thread.
 
 class B1RunAction : public G4UserRunAction
 {
@@ -52,11 +67,23 @@ class B1RunAction : public G4UserRunAction
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
 
-    void AddEdep (G4double edep); 
+    void AddEdep (const G4double edep[B1DoseAccumulable::kMaxNofVolumes]); 
+
+    B1StepContext* GetStepContext() const { return fStepContext; }
+    B1StepOutput*  GetStepOutput() const { return fStepOutput; }
+    B1HistogramSet* GetHistograms() { return &fHistograms; }
+    B1TrackKiller* GetTrackKiller() const { return fTrackKiller; }
+    B1RandomSeeds* GetRandomSeeds() const { return fRandomSeeds; }
 
   private:
-    G4Accumulable<G4double> fEdep;
-    G4Accumulable<G4double> fEdep2;
+    B1StepContext*          fStepContext;
+    B1StepOutput*           fStepOutput;
+    B1TrackKiller*          fTrackKiller;
+    B1RandomSeeds*          fRandomSeeds;
+    B1DoseAccumulable       fDose;
+    B1HistogramSet          fHistograms;
+    B1ThreadStatistics      fThreadStatistics;
+    std::chrono::steady_clock::time_point fRunStartTime;
 };
 
 #endif
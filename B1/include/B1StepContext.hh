@@ -0,0 +1,142 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepContext.hh
+/// \brief Definition of the B1StepContext class
+
+#ifndef B1StepContext_h
+#define B1StepContext_h 1
+
+#include "B1StepRecord.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+#include "globals.hh"
+
+#include <map>
+#include <vector>
+
+class G4ParticleDefinition;
+
+/// Per-thread state shared by the user actions, so that the stepping
+/// action needs no run manager lookup and no string copy per step.
+///
+/// The volume ID lookup, indexed by the logical volume instance ID, is
+/// built in BeginOfRun(); the current event ID is set by the event action.
+/// The volume IDs are world = 0, the layers 1 to N in beam order (by
+/// default Al = 1 and Ta = 2) and envelope = N+1; the replicated slices
+/// of a layer, if any, get the volume ID of the layer. The per-volume
+/// arrays of the scoring have the fixed size kMaxNofVolumes, of which
+/// GetNofVolumes() are used in the current run.
+/// The particle names are interned: each particle definition gets an ID
+/// and its name, cut to the record width, is kept in a fixed-size array.
+
+class B1StepContext
+{
+  public:
+    static const G4int kMaxNofVolumes = 32;
+
+    B1StepContext();
+    ~B1StepContext();
+
+    void BeginOfRun();
+    void SetEventID(G4int eventID) { fEventID = eventID; }
+
+    G4int GetEventID() const { return fEventID; }
+    // world, layers and envelope
+    G4int GetNofVolumes() const { return fNofVolumes; }
+    // the depth bins of a layer, 0 for no depth profile
+    G4int GetNofDepthBins(G4int volumeID) const
+      { return fNofDepthBins[volumeID]; }
+    inline G4int GetVolumeID(const G4LogicalVolume* volume) const;
+    // the logical volume of a volume ID, 0 for the world
+    G4LogicalVolume* GetVolume(G4int volumeID) const
+      { return fVolumes[volumeID]; }
+    // true if the volume is filled with replicated slices
+    G4bool HasSlices(G4int volumeID) const
+      { return fSliceDepth[volumeID] > 0; }
+    // the transform to the frame of the volume ID, above its slices
+    inline const G4AffineTransform& GetLocalTransform(
+      const G4VTouchable* touchable, G4int volumeID) const;
+    inline G4int GetParticleID(const G4ParticleDefinition* particle);
+    const char* GetParticleName(G4int particleID) const
+      { return fParticleNames[particleID].name; }
+
+  private:
+    struct ParticleName {
+      char name[B1StepRecord::kParticleNameLength];
+    };
+
+    void  SetVolumeID(const G4LogicalVolume* volume, G4int volumeID);
+    G4int InternParticle(const G4ParticleDefinition* particle);
+
+    G4int                     fEventID;
+    G4int                     fNofVolumes;
+    std::vector<G4int>        fVolumeIDs;     // indexed by instance ID
+    G4LogicalVolume*          fVolumes[kMaxNofVolumes];
+    G4int                     fSliceDepth[kMaxNofVolumes];
+    G4int                     fNofDepthBins[kMaxNofVolumes];
+
+    const G4ParticleDefinition* fLastParticle;
+    G4int                     fLastParticleID;
+    std::map<const G4ParticleDefinition*, G4int> fParticleIDs;
+    std::vector<ParticleName> fParticleNames; // indexed by particle ID
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int B1StepContext::GetVolumeID(const G4LogicalVolume* volume) const
+{
+  std::size_t index = volume->GetInstanceID();
+  return ( index < fVolumeIDs.size() ) ? fVolumeIDs[index] : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline const G4AffineTransform& B1StepContext::GetLocalTransform(
+  const G4VTouchable* touchable, G4int volumeID) const
+{
+  // the replicas fill the foil, so all its steps are in a slice
+  const G4NavigationHistory* history = touchable->GetHistory();
+  return history->GetTransform(history->GetDepth() - fSliceDepth[volumeID]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int B1StepContext::GetParticleID(const G4ParticleDefinition* particle)
+{
+  // consecutive steps mostly belong to the same track
+  if ( particle == fLastParticle ) return fLastParticleID;
+
+  fLastParticle = particle;
+  fLastParticleID = InternParticle(particle);
+  return fLastParticleID;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
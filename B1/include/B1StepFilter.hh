@@ -0,0 +1,87 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepFilter.hh
+/// \brief Definition of the B1StepFilter class
+
+#ifndef B1StepFilter_h
+#define B1StepFilter_h 1
+
+#include "globals.hh"
+
+#include <map>
+#include <set>
+#include <vector>
+
+class B1StepFilterMessenger;
+class G4Step;
+class G4ParticleDefinition;
+class G4VProcess;
+
+/// Selection of the steps written to the step output.
+///
+/// A step is written if it passes all the active criteria: volume ID,
+/// particle type, minimum energy deposit, kinetic energy range and the
+/// process which limited the step. The cheap numeric criteria are tested
+/// first; particles and processes are compared by pointer, the names
+/// given via /B1/filter/ commands being resolved on first use.
+/// The filter does not affect the dose accumulation.
+
+class B1StepFilter
+{
+  public:
+    B1StepFilter();
+    ~B1StepFilter();
+
+    void SetVolumes(const std::vector<G4int>& volumeIDs);
+    void SetParticles(const std::vector<G4String>& names);
+    void SetProcesses(const std::vector<G4String>& names);
+    void SetMinEdep(G4double edep) { fMinEdep = edep; }
+    void SetKineticEnergyRange(G4double min, G4double max);
+    void Reset();
+
+    G4bool Accept(const G4Step* step, G4int volumeID);
+
+  private:
+    G4bool AcceptParticle(const G4ParticleDefinition* particle);
+    G4bool AcceptProcess(const G4VProcess* process);
+
+    B1StepFilterMessenger* fMessenger;
+
+    std::vector<G4bool>    fVolumes;      // indexed by volume ID
+    G4double               fMinEdep;
+    G4double               fMinKinEnergy;
+    G4double               fMaxKinEnergy;
+
+    std::set<G4String>     fParticleNames;
+    std::map<const G4ParticleDefinition*, G4bool> fParticleCache;
+    std::set<G4String>     fProcessNames;
+    std::map<const G4VProcess*, G4bool> fProcessCache;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepFilterMessenger.hh
+/// \brief Definition of the B1StepFilterMessenger class
+
+#ifndef B1StepFilterMessenger_h
+#define B1StepFilterMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1StepFilter;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+/// Messenger class that defines commands for B1StepFilter.
+///
+/// It implements commands:
+/// - /B1/filter/volumes id1 id2 ... | all
+/// - /B1/filter/particles name1 name2 ... | all
+/// - /B1/filter/processes name1 name2 ... | all
+/// - /B1/filter/minEdep value unit
+/// - /B1/filter/kineticEnergyRange min max unit
+/// - /B1/filter/reset
+
+class B1StepFilterMessenger: public G4UImessenger
+{
+  public:
+    B1StepFilterMessenger(B1StepFilter* filter);
+    virtual ~B1StepFilterMessenger();
+    
+    virtual void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+    B1StepFilter*              fStepFilter;
+
+    G4UIdirectory*             fFilterDirectory;
+    G4UIcmdWithAString*        fVolumesCmd;
+    G4UIcmdWithAString*        fParticlesCmd;
+    G4UIcmdWithAString*        fProcessesCmd;
+    G4UIcmdWithADoubleAndUnit* fMinEdepCmd;
+    G4UIcommand*               fKinEnergyRangeCmd;
+    G4UIcmdWithoutParameter*   fResetCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
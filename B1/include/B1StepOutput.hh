@@ -0,0 +1,164 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepOutput.hh
+/// \brief Definition of the B1StepOutput class
+
+#ifndef B1StepOutput_h
+#define B1StepOutput_h 1
+
+#include "B1StepRecord.hh"
+#include "B1StepSchema.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <vector>
+
+class B1StepWriter;
+class B1StepWriterThread;
+class B1StepFilter;
+class B1EventOutput;
+class B1OutputMessenger;
+
+/// Step output manager.
+///
+/// The stepping action fills the records returned by NextRecord(), which
+/// are kept in a preallocated block and handed to the writer of the
+/// selected format when the block is full. The output files run_N.<ext>
+/// are opened with the first record, so the format can be chosen in the
+/// macro via /B1/output/format before the run starts.
+///
+/// In multi-threading mode each worker writes its own shard files
+/// run_r<runID>_t<threadID>_<k>.<ext>; at the end of run the master
+/// concatenates the k-th shards of all workers into run_N.<ext>,
+/// unless the merging is switched off via /B1/output/merge.
+///
+/// By default the full blocks are serialized and written by a
+/// B1StepWriterThread, so the tracking does not wait for the disk unless
+/// all /B1/output/nofBuffers buffers are in flight.
+///
+/// A new file is started at the beginning of an event when the current
+/// one has reached /B1/output/maxEventsPerFile events, /B1/output/maxFileSize
+/// or /B1/output/maxFileTime. Each data file gets a run_N.idx index of its
+/// blocks (see B1StepWriter), which follows the shards through the merging.
+///
+/// The columns of the files are selected via /B1/output/columns (see
+/// B1StepSchema). It also owns the B1StepFilter applied by the stepping
+/// action before a record is requested.
+///
+/// With /B1/output/mode events (or both), the B1EventOutput writes one
+/// summary per event instead of (or in addition to) the steps.
+///
+/// All the output files, including the histograms, are written in the
+/// /B1/output/directory, by default the current directory.
+
+class B1StepOutput
+{
+  public:
+    B1StepOutput();
+    ~B1StepOutput();
+
+    void SetFormat(const G4String& format);
+    void SetColumns(const G4String& columns);
+    void SetMode(const G4String& mode);
+    void SetBlockSize(G4int blockSize);
+    void SetMerge(G4bool merge) { fMerge = merge; }
+    void SetAsync(G4bool async);
+    void SetNofBuffers(G4int nofBuffers);
+    void SetMaxEventsPerFile(G4int maxEvents) { fMaxEventsPerFile = maxEvents; }
+    void SetMaxFileSize(G4double maxSize) { fMaxFileSize = maxSize; }
+    void SetMaxFileTime(G4double maxTime) { fMaxFileTime = maxTime; }
+    void SetIndex(G4bool index);
+    void SetDirectory(const G4String& directory);
+
+    const G4String& GetFormat() const { return fFormat; }
+    // empty or ending with a slash, to prefix the file names
+    const G4String& GetDirectory() const { return fDirectory; }
+    const B1StepSchema& GetSchema() const { return fSchema; }
+    B1StepFilter*   GetStepFilter() const { return fStepFilter; }
+    B1EventOutput*  GetEventOutput() const { return fEventOutput; }
+    G4bool WritesSteps() const { return fWriteSteps; }
+    G4bool WritesEvents() const { return fWriteEvents; }
+
+    void BeginOfRun(G4int runID);
+    void EndOfRun();
+    void BeginOfEvent();
+
+    void Open();
+    void Close();
+
+    B1StepRecord& NextRecord();
+
+  private:
+    void Flush();
+    void Merge();
+    void MergeIndex(const std::vector<G4String>& shards,
+                    const std::vector<G4long>& offsetShifts,
+                    const G4String& mergedFile,
+                    const G4String& mergedIndex) const;
+    B1StepWriter* CreateWriter() const;
+    G4String GetShardName(G4int threadID, G4int shardIndex) const;
+
+    B1OutputMessenger*        fMessenger;
+    B1StepFilter*             fStepFilter;
+    B1EventOutput*            fEventOutput;
+    B1StepWriter*             fWriter;
+    B1StepWriterThread*       fWriterThread;
+    G4String                  fFormat;
+    G4String                  fDirectory;
+    B1StepSchema              fSchema;
+    std::vector<B1StepRecord> fBlock;
+    std::size_t               fNofRecords;
+    G4int                     fFileCount;
+    G4int                     fRunID;
+    G4int                     fShardCount;
+    G4bool                    fMerge;
+    G4bool                    fAsync;
+    G4int                     fNofBuffers;
+    G4bool                    fIndex;
+    G4bool                    fWriteSteps;
+    G4bool                    fWriteEvents;
+
+    // rotation of the files
+    G4int                     fMaxEventsPerFile;
+    G4double                  fMaxFileSize;  // in bytes
+    G4double                  fMaxFileTime;  // Geant4 time units
+    G4int                     fNofEventsInFile;
+    std::chrono::steady_clock::time_point fFileOpenTime;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline B1StepRecord& B1StepOutput::NextRecord()
+{
+  if ( ! fWriter ) Open();
+  if ( fNofRecords == fBlock.size() ) Flush();
+  return fBlock[fNofRecords++];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
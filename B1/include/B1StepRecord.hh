@@ -0,0 +1,71 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepRecord.hh
+/// \brief Definition of the B1StepRecord structure
+
+#ifndef B1StepRecord_h
+#define B1StepRecord_h 1
+
+#include "globals.hh"
+
+/// Plain record of one step as written to the run_N output files.
+///
+/// The values are stored already converted to the units used in the
+/// output (keV, ns, um), so the writers only have to serialize them.
+/// Only the fields of the columns selected in B1StepSchema are filled.
+
+struct B1StepRecord
+{
+  // the longest Geant4 names, e.g. anti_doublehyperdoubleneutron or
+  // the excited ions, with the terminating zero
+  static const G4int kParticleNameLength = 32;
+
+  G4int    eventID;
+  char     particle[kParticleNameLength];  // zero padded particle name
+  G4int    volumeID;
+  G4double edep;        // keV
+  G4double kinEnergy;   // keV
+  G4double globalTime;  // ns
+  G4double stepLength;  // um
+  G4double momentum;    // keV
+  G4double x;           // um
+  G4double y;           // um
+  G4double z;           // um
+  G4double localX;      // um, in the frame of the scoring volume
+  G4double localY;      // um
+  G4double localZ;      // um
+  G4double px;          // keV
+  G4double py;          // keV
+  G4double pz;          // keV
+  G4int    trackID;
+  G4int    parentID;
+  G4int    sliceID;     // copy number of the foil slice, 0 if not sliced
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
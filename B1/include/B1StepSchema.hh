@@ -0,0 +1,115 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepSchema.hh
+/// \brief Definition of the B1StepSchema class
+
+#ifndef B1StepSchema_h
+#define B1StepSchema_h 1
+
+#include "B1StepRecord.hh"
+#include "globals.hh"
+
+#include <cstddef>
+#include <vector>
+
+/// Description of one output field: where it is found in B1StepRecord
+/// and how it is named in the text, binary and ROOT formats.
+
+struct B1StepField
+{
+  G4int       column;      // B1StepSchema::Column selecting the field
+  const char* name;        // text descriptor and ROOT branch name
+  const char* shortName;   // binary header name
+  char        type;        // 'I' int32, 'D' float64, 'C' fixed width string
+  G4int       width;       // in bytes
+  const char* unit;
+  std::size_t offset;      // in B1StepRecord
+
+  template <typename T>
+  const T& Get(const B1StepRecord& record) const
+    { return *reinterpret_cast<const T*>(
+        reinterpret_cast<const char*>(&record) + offset); }
+  void* Address(B1StepRecord& record) const
+    { return reinterpret_cast<char*>(&record) + offset; }
+};
+
+/// Set of the columns written to the step output, selected at run time
+/// with /B1/output/columns.
+///
+/// The event ID is always written; the other columns are given by their
+/// keys (see GetCandidates()) and are written in a fixed order whatever
+/// the order of the keys. The stepping action computes only the fields
+/// of the selected columns, so the expensive ones (e.g. the local
+/// position) cost nothing when they are not requested.
+
+class B1StepSchema
+{
+  public:
+    enum Column {
+      kParticle       = 1 << 0,
+      kVolume         = 1 << 1,
+      kEdep           = 1 << 2,
+      kKinEnergy      = 1 << 3,
+      kTime           = 1 << 4,
+      kStepLength     = 1 << 5,
+      kMomentum       = 1 << 6,
+      kPosition       = 1 << 7,
+      kLocalPosition  = 1 << 8,
+      kMomentumVector = 1 << 9,
+      kTrackID        = 1 << 10,
+      kParentID       = 1 << 11,
+      kSlice          = 1 << 12
+    };
+
+    // the columns of the original run_N.dat layout
+    static const G4int kDefaultColumns
+      = kParticle | kVolume | kEdep | kKinEnergy | kTime | kStepLength
+      | kMomentum | kPosition;
+
+    B1StepSchema();
+
+    // comma or space separated keys, "default" for the default columns;
+    // returns false and keeps the current columns if a key is unknown
+    G4bool   SetColumns(const G4String& keys);
+    G4String GetColumnKeys() const;
+
+    G4int  GetColumns() const { return fColumns; }
+    G4bool Has(Column column) const { return ( fColumns & column ) != 0; }
+    const std::vector<const B1StepField*>& GetFields() const { return fFields; }
+
+    static G4String GetCandidates();
+
+  private:
+    void SelectFields();
+
+    G4int fColumns;
+    std::vector<const B1StepField*> fFields;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
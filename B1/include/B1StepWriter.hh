@@ -0,0 +1,101 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepWriter.hh
+/// \brief Definition of the B1StepWriter class
+
+#ifndef B1StepWriter_h
+#define B1StepWriter_h 1
+
+#include "B1StepRecord.hh"
+#include "B1StepSchema.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <fstream>
+#include <istream>
+#include <vector>
+
+/// Abstract writer of step records.
+///
+/// The records are handed over in blocks by B1StepOutput; each concrete
+/// writer defines the file format (see B1TextStepWriter,
+/// B1BinaryStepWriter and B1RootStepWriter) and writes the fields of
+/// the schema it was created with.
+///
+/// If an index file is opened, every written block adds a line
+///   file offset nofSteps firstEventID lastEventID
+/// where offset is the byte offset of the block in the data file
+/// (the entry number of its first step for ROOT files), so that readers
+/// can seek to an event without scanning the files.
+
+class B1StepWriter
+{
+  public:
+    B1StepWriter(const B1StepSchema& schema);
+    virtual ~B1StepWriter();
+
+    virtual G4bool Open(const G4String& fileName) = 0;
+    virtual void   WriteBlock(const std::vector<B1StepRecord>& records,
+                              std::size_t nofRecords) = 0;
+    virtual void   Close() = 0;
+
+    // file name extension including the dot, e.g. ".dat"
+    virtual G4String GetExtension() const = 0;
+
+    // positions the stream of a file in this format after its header,
+    // used when concatenating shard files
+    virtual G4bool SkipHeader(std::istream& input) const = 0;
+
+    // merges the given files into output; the default implementation
+    // concatenates them, keeping only the header of the first one.
+    // offsetShifts get the values to add to the index offsets of each input
+    virtual G4bool MergeFiles(const std::vector<G4String>& inputs,
+                              const G4String& output,
+                              std::vector<G4long>& offsetShifts) const;
+
+    G4bool OpenIndex(const G4String& indexFileName,
+                     const G4String& dataFileName);
+    void   CloseIndex();
+
+    // may be called from another thread than the one writing
+    G4long GetBytesWritten() const { return fBytesWritten; }
+
+  protected:
+    void IndexBlock(G4long offset, const std::vector<B1StepRecord>& records,
+                    std::size_t nofRecords);
+
+    B1StepSchema        fSchema;
+    std::atomic<G4long> fBytesWritten;
+
+  private:
+    std::ofstream fIndex;
+    G4String      fDataFileName;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,82 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepWriterThread.hh
+/// \brief Definition of the B1StepWriterThread class
+
+#ifndef B1StepWriterThread_h
+#define B1StepWriterThread_h 1
+
+#include "B1StepRecord.hh"
+#include "globals.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class B1StepWriter;
+
+/// Background thread serializing blocks of step records.
+///
+/// Submit() swaps the filled block for an empty one from a fixed pool of
+/// buffers and returns immediately; the blocks are written in submission
+/// order by a dedicated thread. When all buffers are in flight, Submit()
+/// waits for the writer, which bounds the memory to nofBuffers blocks.
+/// The destructor writes the pending blocks and joins the thread.
+
+class B1StepWriterThread
+{
+  public:
+    B1StepWriterThread(B1StepWriter* writer,
+                       G4int nofBuffers, std::size_t blockSize);
+    ~B1StepWriterThread();
+
+    void Submit(std::vector<B1StepRecord>& block, std::size_t nofRecords);
+
+  private:
+    struct Job
+    {
+      std::vector<B1StepRecord> records;
+      std::size_t               nofRecords;
+    };
+
+    void Run();
+
+    B1StepWriter*                          fWriter;
+    std::deque<Job>                        fQueue;
+    std::vector< std::vector<B1StepRecord> > fFreeBuffers;
+    std::mutex                             fMutex;
+    std::condition_variable                fJobReady;
+    std::condition_variable                fBufferFree;
+    G4bool                                 fStop;
+    std::thread                            fThread;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
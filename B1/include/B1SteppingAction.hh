@@ -33,11 +33,12 @@
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
 
-#include <fstream>
-
 class B1EventAction;
-
-class G4LogicalVolume;
+class B1StepContext;
+class B1StepOutput;
+class B1StepFilter;
+class B1HistogramSet;
+class B1TrackKiller;
 
 /// Stepping action class
 /// 
@@ -45,18 +46,21 @@ class G4LogicalVolume;
 class B1SteppingAction : public G4UserSteppingAction
 {
   public:
-    B1SteppingAction(B1EventAction* eventAction);
+    B1SteppingAction(B1EventAction* eventAction, B1StepContext* stepContext,
+                     B1StepOutput* stepOutput, B1HistogramSet* histograms,
+                     B1TrackKiller* trackKiller);
     virtual ~B1SteppingAction();
 
     // method from the base class
     virtual void UserSteppingAction(const G4Step*);
 
-    std::ofstream ofile;
-
   private:
-    B1EventAction*  fEventAction;
-    G4LogicalVolume* fScoringVolumeInitial;
-    G4LogicalVolume* fScoringVolumeStop;
+    B1EventAction*   fEventAction;
+    B1StepContext*   fStepContext;
+    B1StepOutput*    fStepOutput;
+    B1StepFilter*    fStepFilter;
+    B1HistogramSet*  fHistograms;
+    B1TrackKiller*   fTrackKiller;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
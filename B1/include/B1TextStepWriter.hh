@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TextStepWriter.hh
+/// \brief Definition of the B1TextStepWriter class
+
+#ifndef B1TextStepWriter_h
+#define B1TextStepWriter_h 1
+
+#include "B1StepWriter.hh"
+
+#include <fstream>
+
+/// Writer of the whitespace separated ASCII format, one step per line,
+/// with the TTree::ReadFile descriptor as the first line.
+///
+/// The numbers are formatted with std::to_chars (snprintf before C++17)
+/// into a buffer holding the whole block, with the conversions and the
+/// column widths of the former ostream output, so the files are
+/// identical byte for byte.
+
+class B1TextStepWriter : public B1StepWriter
+{
+  public:
+    B1TextStepWriter(const B1StepSchema& schema);
+    virtual ~B1TextStepWriter();
+
+    virtual G4bool Open(const G4String& fileName);
+    virtual void   WriteBlock(const std::vector<B1StepRecord>& records,
+                              std::size_t nofRecords);
+    virtual void   Close();
+
+    virtual G4String GetExtension() const { return ".dat"; }
+    virtual G4bool   SkipHeader(std::istream& input) const;
+
+  private:
+    std::ofstream     fFile;
+    std::vector<char> fBuffer;  // reused between blocks
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
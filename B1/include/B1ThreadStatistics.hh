@@ -0,0 +1,70 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ThreadStatistics.hh
+/// \brief Definition of the B1ThreadStatistics class
+
+#ifndef B1ThreadStatistics_h
+#define B1ThreadStatistics_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <map>
+
+/// Accumulable of the number of events processed by each worker thread
+/// in a run, and of the wall-clock time of its run.
+///
+/// Each worker adds its own entry at its end of run, even without any
+/// event; the G4AccumulableManager merges them on master, which prints
+/// them, so that an uneven event dispatch (see the -e option of
+/// exampleB1) shows as threads idle before the end of the run.
+
+class B1ThreadStatistics : public G4VAccumulable
+{
+  public:
+    B1ThreadStatistics(const G4String& name);
+    virtual ~B1ThreadStatistics();
+
+    void AddRun(G4int threadID, G4int nofEvents, G4double runTime);
+
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    void Print() const;
+
+  private:
+    struct Entry {
+      G4int    nofEvents;
+      G4double runTime;     // in seconds
+    };
+
+    std::map<G4int, Entry> fEntries;   // by thread ID
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,114 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKiller.hh
+/// \brief Definition of the B1TrackKiller class
+
+#ifndef B1TrackKiller_h
+#define B1TrackKiller_h 1
+
+#include "G4VAccumulable.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4Step;
+class G4Track;
+class B1StepContext;
+class B1TrackKillerMessenger;
+
+/// Region of interest (ROI) outside of which the tracks are not followed.
+///
+/// The ROI is the intersection of the active criteria set with the
+/// /B1/roi/ commands: a box in the world frame, a set of volume IDs, a
+/// minimum kinetic energy and a maximum global time. A new track out of
+/// the ROI is killed by the stacking action before its first step; a
+/// track leaving it is stopped by the stepping action after the step,
+/// which is scored as usual. The kinetic energy of the killed tracks is
+/// not deposited. Without any criterion, no track is killed.
+///
+/// The kill counters are an accumulable: each thread counts its own
+/// tracks, and the G4AccumulableManager merges them on master, which
+/// prints them at the end of run.
+
+class B1TrackKiller : public G4VAccumulable
+{
+  public:
+    enum Reason {
+      kLowEnergy,             // below the minimum kinetic energy
+      kLateTime,              // beyond the maximum global time
+      kOutsideBox,
+      kOutsideVolumes,
+      kNofReasons
+    };
+
+    B1TrackKiller(const G4String& name, const B1StepContext* stepContext);
+    virtual ~B1TrackKiller();
+
+    void SetBox(const G4ThreeVector& min, const G4ThreeVector& max);
+    void SetVolumes(const std::vector<G4int>& volumeIDs);
+    void SetMinKinEnergy(G4double kinEnergy);
+    void SetMaxTime(G4double time);
+    void Clear();
+
+    G4bool IsActive() const { return fIsActive; }
+    // true if the new track is out of the ROI, counted as killed
+    G4bool KillAtBirth(const G4Track* track);
+    // stops the track if it left the ROI in this step
+    void Check(const G4Step* step);
+
+    virtual void Merge(const G4VAccumulable& other);
+    virtual void Reset();
+
+    void Print() const;
+
+  private:
+    enum Stage { kAtBirth, kInFlight, kNofStages };
+
+    // the reason to kill a track in this state, kNofReasons if none
+    Reason Test(G4double kinEnergy, G4double time,
+                const G4ThreeVector& position, G4int volumeID) const;
+    void   UpdateActive();
+
+    const B1StepContext*    fStepContext;
+    B1TrackKillerMessenger* fMessenger;
+
+    G4bool                  fIsActive;
+    G4bool                  fUseBox;
+    G4ThreeVector           fBoxMin;
+    G4ThreeVector           fBoxMax;
+    std::vector<G4bool>     fVolumes;       // indexed by volume ID
+    G4double                fMinKinEnergy;
+    G4double                fMaxTime;
+
+    G4int                   fNofKilled[kNofStages][kNofReasons];
+    G4double                fKilledEnergy[kNofStages];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKillerMessenger.hh
+/// \brief Definition of the B1TrackKillerMessenger class
+
+#ifndef B1TrackKillerMessenger_h
+#define B1TrackKillerMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class B1TrackKiller;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+/// Messenger class that defines commands for B1TrackKiller.
+///
+/// It implements commands:
+/// - /B1/roi/box xmin xmax ymin ymax zmin zmax unit
+/// - /B1/roi/volumes id1 id2 ... | all
+/// - /B1/roi/minKineticEnergy value unit
+/// - /B1/roi/maxTime value unit
+/// - /B1/roi/clear
+
+class B1TrackKillerMessenger: public G4UImessenger
+{
+  public:
+    B1TrackKillerMessenger(B1TrackKiller* trackKiller);
+    virtual ~B1TrackKillerMessenger();
+
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    B1TrackKiller*             fTrackKiller;
+
+    G4UIdirectory*             fRoiDirectory;
+    G4UIcommand*               fBoxCmd;
+    G4UIcmdWithAString*        fVolumesCmd;
+    G4UIcmdWithADoubleAndUnit* fMinKinEnergyCmd;
+    G4UIcmdWithADoubleAndUnit* fMaxTimeCmd;
+    G4UIcmdWithoutParameter*   fClearCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1VacuumTransportModel.hh
+/// \brief Definition of the B1VacuumTransportModel class
+
+#ifndef B1VacuumTransportModel_h
+#define B1VacuumTransportModel_h 1
+
+#include "G4VFastSimulationModel.hh"
+#include "globals.hh"
+
+class B1DetectorConstruction;
+
+/// Fast simulation model of the transport through the envelope gas.
+///
+/// When the envelope material is lighter than the density threshold of
+/// the detector construction (/B1/det/vacuumDensity), a charged particle
+/// in the envelope is moved straight, in one step and without any energy
+/// loss, to just before the next surface: the front face of a layer or
+/// the envelope boundary. The last nanometre is left to the normal
+/// transport, so that the particle enters the next volume as usual.
+/// The step is scored and written as any other step; the step limits of
+/// the envelope region do not apply to it.
+///
+/// The model is thread-local and attached to the "Envelope" region; it
+/// needs the G4FastSimulationPhysics of the physics list.
+
+class B1VacuumTransportModel : public G4VFastSimulationModel
+{
+  public:
+    B1VacuumTransportModel(const G4String& name, G4Envelope* envelope,
+                           const B1DetectorConstruction* detector);
+    virtual ~B1VacuumTransportModel();
+
+    // methods from the base class
+    virtual G4bool IsApplicable(const G4ParticleDefinition& particle);
+    virtual G4bool ModelTrigger(const G4FastTrack& fastTrack);
+    virtual void   DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep);
+
+  private:
+    // along the track direction, in the envelope frame
+    G4double DistanceToNextSurface(const G4FastTrack& fastTrack) const;
+
+    const B1DetectorConstruction* fDetector;
+    G4double fDistance;       // computed by ModelTrigger() for DoIt()
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,167 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1BinaryStepWriter.cc
+/// \brief Implementation of the B1BinaryStepWriter class
+
+#include "B1BinaryStepWriter.hh"
+
+#include <cstdint>
+#include <cstring>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1BinaryStepWriter::B1BinaryStepWriter(const B1StepSchema& schema)
+: B1StepWriter(schema)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1BinaryStepWriter::~B1BinaryStepWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+void B1BinaryStepWriter::Put(const T& value)
+{
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  fBuffer.insert(fBuffer.end(), bytes, bytes + sizeof(T));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1BinaryStepWriter::Open(const G4String& fileName)
+{
+  fFile.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if ( ! fFile.is_open() ) return false;
+
+  WriteHeader();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1BinaryStepWriter::WriteHeader()
+{
+  fBuffer.clear();
+
+  const char magic[8] = { 'B', '1', 'S', 'T', 'E', 'P', 'S', '\0' };
+  fBuffer.insert(fBuffer.end(), magic, magic + sizeof(magic));
+  Put<std::uint32_t>(kVersion);
+  Put<std::uint32_t>(0x01020304);
+  const std::vector<const B1StepField*>& fields = fSchema.GetFields();
+  Put<std::uint32_t>(fields.size());
+
+  for ( std::size_t i = 0; i < fields.size(); ++i ) {
+    const B1StepField& field = *fields[i];
+    Put<char>(field.type);
+    Put<std::uint8_t>(field.width);
+    std::uint8_t nameLength = std::strlen(field.shortName);
+    Put<std::uint8_t>(nameLength);
+    fBuffer.insert(fBuffer.end(), field.shortName,
+                   field.shortName + nameLength);
+    std::uint8_t unitLength = std::strlen(field.unit);
+    Put<std::uint8_t>(unitLength);
+    fBuffer.insert(fBuffer.end(), field.unit, field.unit + unitLength);
+  }
+
+  fFile.write(fBuffer.data(), fBuffer.size());
+  fBytesWritten = fBuffer.size();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1BinaryStepWriter::WriteBlock(const std::vector<B1StepRecord>& records,
+                                    std::size_t nofRecords)
+{
+  if ( nofRecords == 0 ) return;
+
+  // transpose the block of records into columns
+  fBuffer.clear();
+  Put<std::uint32_t>(nofRecords);
+
+  const std::vector<const B1StepField*>& fields = fSchema.GetFields();
+  for ( std::size_t j = 0; j < fields.size(); ++j ) {
+    const B1StepField& field = *fields[j];
+    std::size_t i;
+    switch ( field.type ) {
+      case 'I':
+        for ( i = 0; i < nofRecords; ++i ) {
+          Put<std::int32_t>(field.Get<G4int>(records[i]));
+        }
+        break;
+      case 'D':
+        for ( i = 0; i < nofRecords; ++i ) {
+          Put<double>(field.Get<G4double>(records[i]));
+        }
+        break;
+      default:
+        for ( i = 0; i < nofRecords; ++i ) {
+          const char* value = &field.Get<char>(records[i]);
+          fBuffer.insert(fBuffer.end(), value, value + field.width);
+        }
+        break;
+    }
+  }
+
+  IndexBlock(fBytesWritten, records, nofRecords);
+  fFile.write(fBuffer.data(), fBuffer.size());
+  fBytesWritten += fBuffer.size();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1BinaryStepWriter::SkipHeader(std::istream& input) const
+{
+  // magic, version, byte order mark
+  input.ignore(8 + 2*sizeof(std::uint32_t));
+
+  std::uint32_t nofColumns = 0;
+  input.read(reinterpret_cast<char*>(&nofColumns), sizeof(nofColumns));
+  for ( std::uint32_t i = 0; i < nofColumns && input.good(); ++i ) {
+    // type and width
+    input.ignore(2);
+    // name and unit
+    for ( G4int j = 0; j < 2; ++j ) {
+      std::uint8_t length = 0;
+      input.read(reinterpret_cast<char*>(&length), sizeof(length));
+      input.ignore(length);
+    }
+  }
+  return input.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1BinaryStepWriter::Close()
+{
+  if ( fFile.is_open() ) fFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
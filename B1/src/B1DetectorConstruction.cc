@@ -28,10 +28,14 @@
 /// \brief Implementation of the B1DetectorConstruction class
 
 #include "B1DetectorConstruction.hh"
-#include "B2bChamberParameterisation.hh"
+#include "B1DetectorMessenger.hh"
+#include "B1VacuumTransportModel.hh"
+#include "B1StepContext.hh"
 
 
 #include "G4RunManager.hh"
+#include "G4StateManager.hh"
+#include "G4UIcommand.hh"
 
 #include "G4NistManager.hh"
 
@@ -44,47 +48,112 @@
 
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
-#include "G4PVParameterised.hh"
 #include "G4PVReplica.hh"
 
 #include "G4SystemOfUnits.hh"
 
 #include "G4OpBoundaryProcess.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4UserLimits.hh"
+
+#include <cfloat>
+
+#include <fstream>
+#include <sstream>
+namespace
+{
+  // the region, and so its model, is kept when the geometry is rebuilt
+  G4ThreadLocal B1VacuumTransportModel* vacuumModel = 0;
+
+  G4String GetLayerRegionName(G4int layerID)
+  {
+    G4String name = "Layer";
+    name.append(std::to_string(layerID));
+    return name;
+  }
+
+  // an optional trailing column: kept at its default if the line has no
+  // more tokens, false if the next token is not an integer
+  G4bool ReadOptional(std::istringstream& is, G4int& value)
+  {
+    if ( ( is >> std::ws ).eof() ) return true;
+    return static_cast<bool>(is >> value);
+  }
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1DetectorConstruction::B1DetectorConstruction()
 : G4VUserDetectorConstruction(),
   fScoringVolumeEnv(0),
-  fScoringVolume1(0),
-  fScoringVolume2(0)
-{ }
+  fVacuum(0),
+  fEnvMaterial(0),
+  fEnvCut(0.),
+  fEnvMaxStep(0.),
+  fVacuumDensity(1.e-10*g/cm3),
+  fMessenger(0)
+{
+  DefineMaterials();
+
+  // the original two foils; the Ta centre is 1 cm after the Al back face
+  Layer foilAl = { "foilAl", fVacuum, 15*micrometer, 0., 1, 0,
+                   0., 0. };
+  Layer foilTa = { "foilTa", G4NistManager::Instance()->FindOrBuildMaterial("G4_Ta"),
+                   100*micrometer, 1*cm - 50*micrometer, 1, 0,
+                   0., 0. };
+  fLayers.push_back(foilAl);
+  fLayers.push_back(foilTa);
+
+  fMessenger = new B1DetectorMessenger(this);
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1DetectorConstruction::~B1DetectorConstruction()
-{ }
+{
+  delete fMessenger;
+  std::map<G4String, G4ProductionCuts*>::iterator it;
+  for ( it = fRegionCuts.begin(); it != fRegionCuts.end(); ++it ) {
+    delete it->second;
+  }
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-G4VPhysicalVolume* B1DetectorConstruction::Construct()
-{  
-  // Get nist material manager
-  G4NistManager* nist = G4NistManager::Instance();
-
+void B1DetectorConstruction::DefineMaterials()
+{
+  // the vacuum, defined once for all the volumes and geometry rebuilds
   G4double atomicNumber = 7.;
   G4double massOfMole = 28.02*g/mole;
   G4double density = 1.e-25*g/cm3;
   G4double temperature = 300*kelvin;
   G4double pressure = 3.e-18*pascal;
+  fVacuum = new G4Material("interGalactic", atomicNumber,
+                           massOfMole, density, kStateGas,
+                           temperature, pressure);
 
-  
+  /*G4double shape1_density = 2.7*g/cm3;
+  G4double shape1_a = 26.98*g/mole;
+  G4double z;
+  G4Material* shape1_mat = new G4Material("Aluminium","Al", z=13, shape1_a, shape1_density);
+*/
+  //G4Material* shape1_mat = nist->FindOrBuildMaterial("G4_Al");
+
+  fEnvMaterial = fVacuum;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VPhysicalVolume* B1DetectorConstruction::Construct()
+{  
   // Envelope parameters
   //
   //G4double env_sizeXY = 20*cm, env_sizeZ = 30*cm;
   G4double env_sizeXY = 200*cm, env_sizeZ = 300*cm;
-  G4Material* env_mat = new G4Material("interGalactic", atomicNumber,
-                                       massOfMole, density, kStateGas,
-                                       temperature, pressure);
+  G4Material* env_mat = fEnvMaterial;
    
   // Option to switch on/off checking of volumes overlaps
   //
@@ -95,9 +164,7 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
   //
   G4double world_sizeXY = 12*env_sizeXY;
   G4double world_sizeZ  = 12*env_sizeZ;
-  G4Material* world_mat = new G4Material("interGalactic", atomicNumber,
-                                         massOfMole, density, kStateGas,
-                                         temperature, pressure);
+  G4Material* world_mat = fVacuum;
   
   G4Box* solidWorld =    
     new G4Box("World",                       //its name
@@ -139,171 +206,391 @@ G4VPhysicalVolume* B1DetectorConstruction::Construct()
                     0,                       //copy number
                     checkOverlaps);          //overlaps checking
  
-  //     
-  // Shape 1
-  //  
-  /*G4double shape1_density = 2.7*g/cm3;
-  G4double shape1_a = 26.98*g/mole;
-  G4double z;
-  G4Material* shape1_mat = new G4Material("Aluminium","Al", z=13, shape1_a, shape1_density);
-*/
-  //G4Material* shape1_mat = nist->FindOrBuildMaterial("G4_Al");
+  //
+  // Layers
+  //
+  // The first layer is centred at z = 0, shifted by its gap, and each
+  // next layer starts at the gap after the back face of the previous one.
+  // Each layer is one volume, sliced in replicas only if requested.
+  fLayerVolumes.clear();
+  G4double zFront = -0.5*fLayers.front().thickness;
+  for ( std::size_t i = 0; i < fLayers.size(); ++i ) {
+    const Layer& layer = fLayers[i];
+    zFront += layer.gap;
+
+    G4Box* solidLayer =
+      new G4Box(layer.name,                  //its name
+                6*cm, 6*cm, 0.5*layer.thickness); //its size
+
+    G4LogicalVolume* logicLayer =
+      new G4LogicalVolume(solidLayer,        //its solid
+                          layer.material,    //its material
+                          layer.name + "_log"); //its name
+
+    G4ThreeVector pos = G4ThreeVector(0*cm, 0*cm, zFront + 0.5*layer.thickness);
+    new G4PVPlacement(0,                     //no rotation
+                      pos,                   //at position
+                      logicLayer,            //its logical volume
+                      layer.name + "_phy",   //its name
+                      logicEnv,              //its mother  volume
+                      false,                 //no boolean operation
+                      0,                     //copy number
+                      checkOverlaps);        //overlaps checking
 
-  G4Material* shape1_mat = new G4Material("interGalactic", atomicNumber,
-                                         massOfMole, density, kStateGas,
-                                         temperature, pressure);
-
-/***************************    Parameterised Test      ****************************************/
-/*
-  G4double thickness1 = 10; //unit:um
-  G4Tubs* chamberS = 
-                    new G4Tubs("tracker",0,3*cm,(thickness1/2)*micrometer, 0*deg, 360.*deg);
-  G4LogicalVolume* logicShape1 = 
-                    new G4LogicalVolume(chamberS, shape1_mat, "foilAl_log");
-  G4int NbOfChambers = 10; 
-  G4double chamberSpacing = 0*micrometer; // from chamber center to center
-  G4double chamberWidth = 6.0*cm; //width of the chambers
-  G4double targetLength = 5.0*cm; //full length of Target
-  G4double trackerLength = (NbOfChambers+1)*chamberSpacing; 
-  G4double trackerSize = 0.5*trackerLength;  
-
-  //G4double firstPosition = trackerSize + chamberSpacing;
-  G4double firstPosition = -4.5*micrometer;
-  //G4double firstLength = trackerLength/10;
-  G4double firstLength = 1*micrometer;
-  //G4double lastLength = trackerLength;
-  G4double lastLength = 1*micrometer;
-  G4VPVParameterisation* chamberParam = 
-                    new ChamberParameterisation(
-                                                NbOfChambers,
-                                                firstPosition,
-                                                chanmberSpacing,
-                                                chamberWidth,
-                                                firstLength,
-                                                lastLength);
-
-  new G4PVParameterised("Chamber",
-                        logicShape1,
-                        logicEnv,
-                        kZAxis,
-                        NbOfChambers,
-                        chamberParam,
-                        checkOverlaps);
+    SliceFoil(logicLayer, layer.nofSlices);
 
+    fLayerVolumes.push_back(logicLayer);
+    zFront += layer.thickness;
+  }
 
+  // Set the layers and the envelope as scoring volumes
+  //
+  fScoringVolumeEnv = logicEnv;
 
-*/
+  SetUpRegions(logicEnv);
 
-/*********************************************************************/
-/****************************** Replicas Test ************************/
-// cannot track ////
+  //
+  //always return the physical World
+  //
+  return physWorld;
+}
 
-/*
-  G4double thickness1 = 10; // thickness of Al foil, unit: um
-  G4double bin1 = 1000; //bin number;  
-  G4double binlen1 = thickness1/bin1; // length of one bin
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  G4double foilAl_x = 6*cm;
-  G4double foilAl_y = 6*cm;
-  G4double foilAl_z =  (binlen1/2)*micrometer;  // thickness for one bin
-  G4Box *foilAl = new G4Box("foilAl", foilAl_x, foilAl_y, foilAl_z);                   
-  //G4Box *foilAl = new G4Box("foilAl", 0,0,0);                   
-  
-  G4LogicalVolume* logicShape1 =                         
-    new G4LogicalVolume(foilAl,         //its solid
-                        shape1_mat,          //its material
-                        "foilAl_log");           //its name
-
-  G4PVReplica ("foilAl_phy",
-                  logicShape1,
-                  logicEnv,
-                  kZAxis,
-                  10,
-                  1*micrometer);
+void B1DetectorConstruction::ConstructSDandField()
+{
+  if ( vacuumModel ) return;
 
-*/
+  G4Region* envRegion
+    = G4RegionStore::GetInstance()->GetRegion("Envelope", false);
+  vacuumModel
+    = new B1VacuumTransportModel("VacuumTransport", envRegion, this);
+}
 
-/************************************************************************/
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-/************************ Dumb Way *************************************/
+void B1DetectorConstruction::SetUpRegions(G4LogicalVolume* envelope) const
+{
+  // The regions are kept across the geometry rebuilds, with their cuts
+  // and limits; only their root volumes are new. The daughter layers of
+  // the envelope are the roots of their own regions. The regions of the
+  // layers removed from the stack are kept too: without a root volume
+  // they are not in the mass geometry and cost nothing, and they are
+  // reused if the stack grows again.
+  G4RegionStore* regionStore = G4RegionStore::GetInstance();
+  for ( G4int id = 0; id <= GetNofLayers(); ++id ) {
+    G4String name = ( id == 0 ) ? G4String("Envelope") : GetLayerRegionName(id);
+    G4Region* region = regionStore->FindOrCreateRegion(name);
+    region->AddRootLogicalVolume( id == 0 ? envelope : GetLayerVolume(id) );
+    if ( ! region->GetUserLimits() ) {
+      region->SetUserLimits(new G4UserLimits);
+    }
+  }
+
+  ApplyRegionSettings();
+}
 
-  G4double thickness1 = 15; // thickness of Al foil, unit: um
-  G4double bin1 = 1; //bin number;  
-  G4double binlen1 = thickness1/bin1; // length of one bin
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  G4double foilAl_x = 6*cm;
-  G4double foilAl_y = 6*cm;
-  G4double foilAl_z =  (binlen1/2)*micrometer;  // thickness for one bin
-  G4Box *foilAl = new G4Box("foilAl", foilAl_x, foilAl_y, foilAl_z);                   
-  
-  G4LogicalVolume* logicShape1 =                         
-    new G4LogicalVolume(foilAl,         //its solid
-                        shape1_mat,          //its material
-                        "foilAl_log");           //its name
+void B1DetectorConstruction::ApplyRegionSettings() const
+{
+  // before the first construction, the settings are applied by Construct()
+  G4RegionStore* regionStore = G4RegionStore::GetInstance();
+  G4Region* envRegion = regionStore->GetRegion("Envelope", false);
+  if ( envRegion ) SetRegionCuts(envRegion, fEnvCut, fEnvMaxStep);
+  for ( G4int id = 1; id <= GetNofLayers(); ++id ) {
+    G4Region* region = regionStore->GetRegion(GetLayerRegionName(id), false);
+    if ( ! region ) continue;
+    SetRegionCuts(region, fLayers[id-1].cut, fLayers[id-1].maxStep);
+  }
+}
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1DetectorConstruction::SetRegionCuts(G4Region* region, G4double cut,
+                                           G4double maxStep) const
+{
+  // without a cut of its own, the region shares the cuts of the default
+  // region, which follow /run/setCut. Its own cuts are kept for a later
+  // cut and deleted with the detector, not when the region goes back to
+  // the default cuts: the couples of the last physics tables still point
+  // to them.
+  if ( cut <= 0. ) {
+    region->SetProductionCuts(
+      G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts());
+  }
+  else {
+    G4ProductionCuts*& cuts = fRegionCuts[region->GetName()];
+    if ( ! cuts ) cuts = new G4ProductionCuts;
+    // the same cut for gamma, e-, e+ and proton
+    cuts->SetProductionCut(cut);
+    region->SetProductionCuts(cuts);
+  }
+  region->GetUserLimits()->SetMaxAllowedStep(maxStep > 0. ? maxStep : DBL_MAX);
+}
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  for(int i=0;i<bin1;i++){
-    G4ThreeVector pos1 = G4ThreeVector(0*cm, 0*cm, -(thickness1/2-binlen1/2-i*binlen1)*micrometer);
-    new G4PVPlacement(0,                       //no rotation
-                    pos1,                    //at position
-                    logicShape1,           //its logical volume
-                    "foilAl_phy",                //its name
-                    logicEnv,                //its mother  volume
-                    false,                   //no boolean operation
-                    0,                       //copy number
-                    checkOverlaps);          //overlaps checking
-  }   
+G4bool B1DetectorConstruction::CheckLayer(G4int layerID) const
+{
+  if ( layerID >= 1 && layerID <= G4int(fLayers.size()) ) return true;
 
+  G4ExceptionDescription msg;
+  msg << "No layer " << layerID << ", the geometry is kept unchanged.";
+  G4Exception("B1DetectorConstruction::CheckLayer()", "MyCode0007",
+              JustWarning, msg);
+  return false;
+}
 
-/********************************************************************************/
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+G4Material* B1DetectorConstruction::FindMaterial(
+  const G4String& materialName) const
+{
+  // the NIST materials are built once, on first use
+  G4Material* material = G4Material::GetMaterial(materialName, false);
+  if ( ! material ) {
+    material = G4NistManager::Instance()->FindOrBuildMaterial(materialName);
+  }
+  if ( ! material ) {
+    G4ExceptionDescription msg;
+    msg << "Unknown material " << materialName
+        << ", the geometry is kept unchanged.";
+    G4Exception("B1DetectorConstruction::FindMaterial()", "MyCode0007",
+                JustWarning, msg);
+  }
+  return material;
+}
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  //     
-  // Shape 2
-  //
+void B1DetectorConstruction::SetThickness(G4int layerID, G4double thickness)
+{
+  if ( ! CheckLayer(layerID) ) return;
+  if ( thickness <= 0. ) {
+    G4ExceptionDescription msg;
+    msg << "The thickness of layer " << layerID << " must be positive,"
+        << " the geometry is kept unchanged.";
+    G4Exception("B1DetectorConstruction::SetThickness()", "MyCode0007",
+                JustWarning, msg);
+    return;
+  }
+  fLayers[layerID-1].thickness = thickness;
+  ReinitializeGeometry();
+}
 
-  G4Material* shape2_mat = nist->FindOrBuildMaterial("G4_Ta");
-        
-  G4double thickness2 = 100; // thickness of Al foil, unit: um
-  G4double bin2 = 1; //bin number;  
-  G4double binlen2 = thickness2/bin2; // length of one bin
-
-  G4double foilTa_x = 6*cm;
-  G4double foilTa_y = 6*cm;
-  G4double foilTa_z =  (binlen2/2)*micrometer;  // thickness for one bin
-  G4Box *foilTa = new G4Box("foilTa", foilTa_x, foilTa_y, foilTa_z);                   
-
-                
-  G4LogicalVolume* logicShape2 =                         
-    new G4LogicalVolume(foilTa,         //its solid
-                        shape2_mat,          //its material
-                        "foilTa_log");           //its name
-  for(int j=0;j<bin2;j++){
-    G4ThreeVector pos2 = G4ThreeVector(0*cm, 0*cm, (thickness1/2+10000-(thickness2/2-binlen2/2-j*binlen2))*micrometer); // distance between Al and Ta is 10000um = 1cm
-    new G4PVPlacement(0,                       //no rotation
-                      pos2,                    //at position
-                      logicShape2,             //its logical volume
-                      "foilTa_phy",                //its name
-                      logicEnv,                //its mother  volume
-                      false,                   //no boolean operation
-                      0,                       //copy number
-                      true);
-                      //checkOverlaps);          //overlaps checking
-   }                
-
-  // Set Shape2 as scoring volume
-  //
-  fScoringVolume1 = logicShape1;
-  fScoringVolume2 = logicShape2;
-  fScoringVolumeEnv = logicEnv;
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  //
-  //always return the physical World
-  //
-  return physWorld;
+void B1DetectorConstruction::SetGap(G4int layerID, G4double gap)
+{
+  if ( ! CheckLayer(layerID) ) return;
+  fLayers[layerID-1].gap = gap;
+  ReinitializeGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetNofSlices(G4int layerID, G4int nofSlices)
+{
+  if ( ! CheckLayer(layerID) ) return;
+  fLayers[layerID-1].nofSlices = nofSlices;
+  ReinitializeGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetNofDepthBins(G4int layerID, G4int nofBins)
+{
+  // scoring only, the geometry is unchanged
+  if ( ! CheckLayer(layerID) ) return;
+  fLayers[layerID-1].nofDepthBins = nofBins;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetMaterial(G4int layerID,
+                                         const G4String& materialName)
+{
+  if ( ! CheckLayer(layerID) ) return;
+  G4Material* material = FindMaterial(materialName);
+  if ( ! material ) return;
+  fLayers[layerID-1].material = material;
+  ReinitializeGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetEnvelopeMaterial(const G4String& materialName)
+{
+  G4Material* material = FindMaterial(materialName);
+  if ( ! material ) return;
+  fEnvMaterial = material;
+  ReinitializeGeometry();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetCut(G4int layerID, G4double cut)
+{
+  if ( ! CheckLayer(layerID) ) return;
+  fLayers[layerID-1].cut = cut;
+  ApplyRegionSettings();
+  PhysicsHasBeenModified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetMaxStep(G4int layerID, G4double maxStep)
+{
+  // read by the step limiter at each step, nothing to rebuild
+  if ( ! CheckLayer(layerID) ) return;
+  fLayers[layerID-1].maxStep = maxStep;
+  ApplyRegionSettings();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetEnvelopeCut(G4double cut)
+{
+  fEnvCut = cut;
+  ApplyRegionSettings();
+  PhysicsHasBeenModified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SetEnvelopeMaxStep(G4double maxStep)
+{
+  fEnvMaxStep = maxStep;
+  ApplyRegionSettings();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1DetectorConstruction::ReadLayers(const G4String& fileName)
+{
+  std::ifstream file(fileName);
+  if ( ! file.is_open() ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open the layer file " << fileName;
+    G4Exception("B1DetectorConstruction::ReadLayers()", "MyCode0003",
+                JustWarning, msg);
+    return false;
+  }
+
+  // one layer per line, in beam order; "#" starts a comment
+  // name material thickness unit gap unit [nofSlices [nofDepthBins]]
+  std::vector<Layer> layers;
+  G4String line;
+  G4int lineNumber = 0;
+  while ( std::getline(file, line) ) {
+    ++lineNumber;
+    std::size_t comment = line.find('#');
+    if ( comment != std::string::npos ) line.erase(comment);
+
+    std::istringstream is(line);
+    G4String name, materialName, thicknessUnit, gapUnit;
+    G4double thickness, gap;
+    if ( ! ( is >> name ) ) continue;
+
+    Layer layer = { name, 0, 0., 0., 1, 0, 0., 0. };
+    G4bool ok = static_cast<bool>(
+      is >> materialName >> thickness >> thicknessUnit >> gap >> gapUnit);
+    ok = ok && ReadOptional(is, layer.nofSlices)
+            && ReadOptional(is, layer.nofDepthBins)
+            && ( is >> std::ws ).eof();
+    // an unknown unit has the value 0
+    G4double thicknessUnitValue = ok ? G4UIcommand::ValueOf(thicknessUnit) : 0.;
+    G4double gapUnitValue = ok ? G4UIcommand::ValueOf(gapUnit) : 0.;
+    if ( ok ) {
+      layer.material = FindMaterial(materialName);
+      layer.thickness = thickness*thicknessUnitValue;
+      layer.gap = gap*gapUnitValue;
+    }
+    if ( ! ok || ! layer.material || thicknessUnitValue <= 0. ||
+         gapUnitValue <= 0. || layer.thickness <= 0. || layer.gap < 0. ||
+         layer.nofSlices < 1 || layer.nofDepthBins < 0 ) {
+      G4ExceptionDescription msg;
+      msg << fileName << ":" << lineNumber << ": invalid layer \""
+          << line << "\", the geometry is kept unchanged.";
+      G4Exception("B1DetectorConstruction::ReadLayers()", "MyCode0007",
+                  JustWarning, msg);
+      return false;
+    }
+    layers.push_back(layer);
+  }
+
+  // world, layers and envelope must fit in the scoring arrays
+  if ( layers.empty() ||
+       G4int(layers.size()) > B1StepContext::kMaxNofVolumes - 2 ) {
+    G4ExceptionDescription msg;
+    msg << fileName << ": " << layers.size() << " layers, 1 to "
+        << B1StepContext::kMaxNofVolumes - 2 << " are supported;"
+        << " the geometry is kept unchanged.";
+    G4Exception("B1DetectorConstruction::ReadLayers()", "MyCode0007",
+                JustWarning, msg);
+    return false;
+  }
+
+  fLayers = layers;
+  ReinitializeGeometry();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::PhysicsHasBeenModified()
+{
+  // the tables of the couples with new cuts are rebuilt at the next run
+  if ( G4StateManager::GetStateManager()->GetCurrentState()
+       != G4State_Idle ) return;
+  G4RunManager::GetRunManager()->PhysicsHasBeenModified();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::ReinitializeGeometry()
+{
+  // before the first initialization, the geometry is just built later
+  if ( G4StateManager::GetStateManager()->GetCurrentState()
+       != G4State_Idle ) return;
+
+  // the old geometry is deleted and rebuilt at the next run, on master
+  // and, by the propagated /run/reinitializeGeometry, on the workers;
+  // the physics tables are kept, and updated only for new materials
+  G4RunManager::GetRunManager()->ReinitializeGeometry(true);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorConstruction::SliceFoil(G4LogicalVolume* foil,
+                                       G4int nofSlices) const
+{
+  if ( nofSlices <= 1 ) return;
+
+  // One replica volume for all the slices: the memory and the
+  // construction time do not grow with the number of slices, and the
+  // slice index is the replica (copy) number, 0 to nofSlices-1 along z.
+  // The replicas fill the foil, so they need no overlap check.
+  G4Box* foilBox = static_cast<G4Box*>(foil->GetSolid());
+  G4double sliceWidth = 2*foilBox->GetZHalfLength()/nofSlices;
+  G4String name = foil->GetName();
+  name = name.substr(0, name.find("_log"));
+
+  G4Box* sliceBox =
+    new G4Box(name + "Slice",                 //its name
+              foilBox->GetXHalfLength(), foilBox->GetYHalfLength(),
+              0.5*sliceWidth);                //its size
+  G4LogicalVolume* logicSlice =
+    new G4LogicalVolume(sliceBox,             //its solid
+                        foil->GetMaterial(),  //its material
+                        name + "Slice_log");  //its name
+  new G4PVReplica(name + "Slice_phy",         //its name
+                  logicSlice,                 //its logical volume
+                  foil,                       //its mother volume
+                  kZAxis,                     //replicated along z
+                  nofSlices,                  //number of replicas
+                  sliceWidth);                //width of one replica
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,244 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1DetectorMessenger.cc
+/// \brief Implementation of the B1DetectorMessenger class
+
+#include "B1DetectorMessenger.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+#include <sstream>
+
+namespace
+{
+  G4UIparameter* NewLayerParameter()
+  {
+    G4UIparameter* layerPrm = new G4UIparameter("layerID",'i',false);
+    layerPrm->SetParameterRange("layerID>=1");
+    return layerPrm;
+  }
+
+  // a layer ID, a length and its unit
+  G4UIcommand* NewLengthCommand(const char* path, G4UImessenger* messenger)
+  {
+    G4UIcommand* command = new G4UIcommand(path,messenger);
+    command->SetParameter(NewLayerParameter());
+    G4UIparameter* valuePrm = new G4UIparameter("value",'d',false);
+    valuePrm->SetParameterRange("value>=0.");
+    command->SetParameter(valuePrm);
+    G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+    unitPrm->SetDefaultUnit("um");
+    command->SetParameter(unitPrm);
+    return command;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::B1DetectorMessenger(B1DetectorConstruction* detector)
+: G4UImessenger(),
+  fDetector(detector),
+  fDetDirectory(0),
+  fLayersCmd(0),
+  fThicknessCmd(0),
+  fGapCmd(0),
+  fSlicesCmd(0),
+  fDepthBinsCmd(0),
+  fMaterialCmd(0),
+  fEnvMaterialCmd(0),
+  fCutCmd(0),
+  fMaxStepCmd(0),
+  fEnvCutCmd(0),
+  fEnvMaxStepCmd(0),
+  fVacuumDensityCmd(0)
+{
+  fDetDirectory = new G4UIdirectory("/B1/det/");
+  fDetDirectory->SetGuidance("Detector geometry control");
+  fDetDirectory->SetGuidance("The layers are numbered 1 to N in beam order, as their");
+  fDetDirectory->SetGuidance("volume IDs. In the Idle state, a change rebuilds the");
+  fDetDirectory->SetGuidance("geometry at the next run, without rebuilding the physics.");
+
+  fLayersCmd = new G4UIcmdWithAString("/B1/det/layers",this);
+  fLayersCmd->SetGuidance("Replace the layers with those of a file, one per line:");
+  fLayersCmd->SetGuidance("name material thickness unit gap unit [nofSlices [nofDepthBins]]");
+  fLayersCmd->SetGuidance("The gap is the distance from the previous layer; the first");
+  fLayersCmd->SetGuidance("layer is centred at z = 0, shifted by its gap.");
+  fLayersCmd->SetParameterName("fileName",false);
+
+  fThicknessCmd = NewLengthCommand("/B1/det/thickness",this);
+  fThicknessCmd->SetGuidance("Set the thickness of a layer.");
+
+  fGapCmd = NewLengthCommand("/B1/det/gap",this);
+  fGapCmd->SetGuidance("Set the distance from the back face of the previous layer");
+  fGapCmd->SetGuidance("to the front face of the layer.");
+
+  fSlicesCmd = new G4UIcommand("/B1/det/slices",this);
+  fSlicesCmd->SetGuidance("Slice a layer along z in replicas;");
+  fSlicesCmd->SetGuidance("the slice index is written with the \"slice\" column.");
+  fSlicesCmd->SetGuidance("1 slice = no slicing. The steps stop at each slice");
+  fSlicesCmd->SetGuidance("boundary: for depth profiles, prefer /B1/det/depthBins.");
+  fSlicesCmd->SetParameter(NewLayerParameter());
+  G4UIparameter* slicesPrm = new G4UIparameter("nofSlices",'i',false);
+  slicesPrm->SetParameterRange("nofSlices>=1");
+  fSlicesCmd->SetParameter(slicesPrm);
+
+  fDepthBinsCmd = new G4UIcommand("/B1/det/depthBins",this);
+  fDepthBinsCmd->SetGuidance("Score the depth profile of a layer over its full thickness");
+  fDepthBinsCmd->SetGuidance("(see /B1/histo/depth), without slicing it; 0 = no profile.");
+  fDepthBinsCmd->SetParameter(NewLayerParameter());
+  G4UIparameter* binsPrm = new G4UIparameter("nofBins",'i',false);
+  binsPrm->SetParameterRange("nofBins>=0");
+  fDepthBinsCmd->SetParameter(binsPrm);
+
+  fMaterialCmd = new G4UIcommand("/B1/det/material",this);
+  fMaterialCmd->SetGuidance("Set the material of a layer: a NIST name, e.g. G4_Al,");
+  fMaterialCmd->SetGuidance("or interGalactic.");
+  fMaterialCmd->SetParameter(NewLayerParameter());
+  G4UIparameter* materialPrm = new G4UIparameter("material",'s',false);
+  fMaterialCmd->SetParameter(materialPrm);
+
+  fEnvMaterialCmd = new G4UIcmdWithAString("/B1/det/envelopeMaterial",this);
+  fEnvMaterialCmd->SetGuidance("Set the material of the envelope.");
+  fEnvMaterialCmd->SetParameterName("material",false);
+
+  fCutCmd = NewLengthCommand("/B1/det/cut",this);
+  fCutCmd->SetGuidance("Set the production cut of the region of a layer;");
+  fCutCmd->SetGuidance("0 (default) = the /run/setCut cuts. The physics tables");
+  fCutCmd->SetGuidance("are updated at the next run.");
+
+  fMaxStepCmd = NewLengthCommand("/B1/det/maxStep",this);
+  fMaxStepCmd->SetGuidance("Set the maximum step length in a layer; 0 = no limit.");
+
+  fEnvCutCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/envelopeCut",this);
+  fEnvCutCmd->SetGuidance("Set the production cut of the envelope region;");
+  fEnvCutCmd->SetGuidance("0 (default) = the /run/setCut cuts.");
+  fEnvCutCmd->SetParameterName("cut",false);
+  fEnvCutCmd->SetRange("cut>=0.");
+  fEnvCutCmd->SetUnitCategory("Length");
+  fEnvCutCmd->SetDefaultUnit("mm");
+
+  fEnvMaxStepCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/envelopeMaxStep",this);
+  fEnvMaxStepCmd->SetGuidance("Set the maximum step length in the envelope; 0 = no limit.");
+  fEnvMaxStepCmd->SetParameterName("maxStep",false);
+  fEnvMaxStepCmd->SetRange("maxStep>=0.");
+  fEnvMaxStepCmd->SetUnitCategory("Length");
+  fEnvMaxStepCmd->SetDefaultUnit("mm");
+
+  fVacuumDensityCmd = new G4UIcmdWithADoubleAndUnit("/B1/det/vacuumDensity",this);
+  fVacuumDensityCmd->SetGuidance("Move the charged particles straight across the envelope");
+  fVacuumDensityCmd->SetGuidance("when its density is below this value (default 1e-10 g/cm3);");
+  fVacuumDensityCmd->SetGuidance("0 = always step through it.");
+  fVacuumDensityCmd->SetParameterName("density",false);
+  fVacuumDensityCmd->SetRange("density>=0.");
+  fVacuumDensityCmd->SetUnitCategory("Volumic Mass");
+  fVacuumDensityCmd->SetDefaultUnit("g/cm3");
+
+  // the geometry is built on master only
+  G4UIcommand* commands[] = {
+    fLayersCmd, fThicknessCmd, fGapCmd, fSlicesCmd, fDepthBinsCmd,
+    fMaterialCmd, fEnvMaterialCmd, fCutCmd, fMaxStepCmd, fEnvCutCmd,
+    fEnvMaxStepCmd, fVacuumDensityCmd
+  };
+  for ( std::size_t i = 0; i < sizeof(commands)/sizeof(commands[0]); ++i ) {
+    commands[i]->AvailableForStates(G4State_PreInit,G4State_Idle);
+    commands[i]->SetToBeBroadcasted(false);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DetectorMessenger::~B1DetectorMessenger()
+{
+  delete fLayersCmd;
+  delete fThicknessCmd;
+  delete fGapCmd;
+  delete fSlicesCmd;
+  delete fDepthBinsCmd;
+  delete fMaterialCmd;
+  delete fEnvMaterialCmd;
+  delete fCutCmd;
+  delete fMaxStepCmd;
+  delete fEnvCutCmd;
+  delete fEnvMaxStepCmd;
+  delete fVacuumDensityCmd;
+  delete fDetDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fLayersCmd ) {
+    fDetector->ReadLayers(newValue);
+  }
+  else if ( command == fThicknessCmd || command == fGapCmd ||
+            command == fCutCmd || command == fMaxStepCmd ) {
+    std::istringstream is(newValue);
+    G4int layerID;
+    G4double value;
+    G4String unit;
+    is >> layerID >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+    if ( command == fThicknessCmd ) fDetector->SetThickness(layerID, value);
+    else if ( command == fGapCmd ) fDetector->SetGap(layerID, value);
+    else if ( command == fCutCmd ) fDetector->SetCut(layerID, value);
+    else fDetector->SetMaxStep(layerID, value);
+  }
+  else if ( command == fSlicesCmd || command == fDepthBinsCmd ) {
+    std::istringstream is(newValue);
+    G4int layerID, n;
+    is >> layerID >> n;
+    if ( command == fSlicesCmd ) fDetector->SetNofSlices(layerID, n);
+    else fDetector->SetNofDepthBins(layerID, n);
+  }
+  else if ( command == fMaterialCmd ) {
+    std::istringstream is(newValue);
+    G4int layerID;
+    G4String material;
+    is >> layerID >> material;
+    fDetector->SetMaterial(layerID, material);
+  }
+  else if ( command == fEnvMaterialCmd ) {
+    fDetector->SetEnvelopeMaterial(newValue);
+  }
+  else if ( command == fEnvCutCmd ) {
+    fDetector->SetEnvelopeCut(fEnvCutCmd->GetNewDoubleValue(newValue));
+  }
+  else if ( command == fEnvMaxStepCmd ) {
+    fDetector->SetEnvelopeMaxStep(fEnvMaxStepCmd->GetNewDoubleValue(newValue));
+  }
+  else if ( command == fVacuumDensityCmd ) {
+    fDetector->SetVacuumDensity(fVacuumDensityCmd->GetNewDoubleValue(newValue));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,77 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1DoseAccumulable.cc
+/// \brief Implementation of the B1DoseAccumulable class
+
+#include "B1DoseAccumulable.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DoseAccumulable::B1DoseAccumulable(const G4String& name)
+: G4VAccumulable(name)
+{
+  Reset();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1DoseAccumulable::~B1DoseAccumulable()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DoseAccumulable::AddEvent(const G4double edep[kMaxNofVolumes])
+{
+  for ( G4int i = 0; i < kMaxNofVolumes; ++i ) {
+    fEdep[i]  += edep[i];
+    fEdep2[i] += edep[i]*edep[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DoseAccumulable::Merge(const G4VAccumulable& other)
+{
+  const B1DoseAccumulable& otherDose
+    = static_cast<const B1DoseAccumulable&>(other);
+  for ( G4int i = 0; i < kMaxNofVolumes; ++i ) {
+    fEdep[i]  += otherDose.fEdep[i];
+    fEdep2[i] += otherDose.fEdep2[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1DoseAccumulable::Reset()
+{
+  for ( G4int i = 0; i < kMaxNofVolumes; ++i ) {
+    fEdep[i]  = 0.;
+    fEdep2[i] = 0.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
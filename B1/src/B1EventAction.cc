@@ -29,17 +29,24 @@
 
 #include "B1EventAction.hh"
 #include "B1RunAction.hh"
+#include "B1StepContext.hh"
+#include "B1StepOutput.hh"
+#include "B1EventOutput.hh"
+#include "B1RandomSeeds.hh"
 
 #include "G4Event.hh"
 #include "G4RunManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1EventAction::B1EventAction(B1RunAction* runAction)
 : G4UserEventAction(),
-  fRunAction(runAction),
-  fEdep(0.)
-{} 
+  fRunAction(runAction)
+{
+  for ( G4int i = 0; i < B1StepContext::kMaxNofVolumes; ++i ) fEdep[i] = 0.;
+} 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -48,9 +55,17 @@ B1EventAction::~B1EventAction()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1EventAction::BeginOfEventAction(const G4Event*)
+void B1EventAction::BeginOfEventAction(const G4Event* event)
 {    
-  fEdep = 0.;
+  for ( G4int i = 0; i < B1StepContext::kMaxNofVolumes; ++i ) fEdep[i] = 0.;
+  fRunAction->GetStepContext()->SetEventID(event->GetEventID());
+  fSummary.Reset(event->GetEventID(),
+                 fRunAction->GetStepContext()->GetNofVolumes());
+  // set by the primary generator action, before this action
+  fSummary.eventSeed = fRunAction->GetRandomSeeds()->GetEventSeed();
+
+  // start a new step file if the current one is full
+  fRunAction->GetStepOutput()->BeginOfEvent();
 // ENTERING EDIT ZONE
 // say when a new event starts?
 //  G4cout << G4endl << "Start event" << G4endl ;
@@ -61,10 +76,49 @@ void B1EventAction::BeginOfEventAction(const G4Event*)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void B1EventAction::AddStep(const G4Step* step, G4int volumeID)
+{
+  if ( volumeID < 0 || volumeID >= B1EventSummary::kMaxNofVolumes ) return;
+
+  fSummary.edep[volumeID] += step->GetTotalEnergyDeposit()/keV;
+  ++fSummary.nofSteps[volumeID];
+
+  // the entry, exit and stop of the primary particle
+  const G4Track* track = step->GetTrack();
+  if ( track->GetParentID() != 0 ) return;
+
+  const G4StepPoint* preStep = step->GetPreStepPoint();
+  const G4StepPoint* postStep = step->GetPostStepPoint();
+  if ( preStep->GetStepStatus() == fGeomBoundary &&
+       fSummary.entryEnergy[volumeID] == 0. ) {
+    fSummary.entryEnergy[volumeID] = preStep->GetKineticEnergy()/keV;
+  }
+  if ( postStep->GetStepStatus() == fGeomBoundary ||
+       postStep->GetStepStatus() == fWorldBoundary ) {
+    fSummary.exitEnergy[volumeID] = postStep->GetKineticEnergy()/keV;
+  }
+  G4TrackStatus status = track->GetTrackStatus();
+  if ( ( status == fStopAndKill || status == fStopButAlive ) &&
+       postStep->GetStepStatus() != fWorldBoundary ) {
+    G4ThreeVector position = postStep->GetPosition();
+    fSummary.stopVolume = volumeID;
+    fSummary.stopX = position.x()/micrometer;
+    fSummary.stopY = position.y()/micrometer;
+    fSummary.stopZ = position.z()/micrometer;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void B1EventAction::EndOfEventAction(const G4Event*)
 {   
   // accumulate statistics in run action
   fRunAction->AddEdep(fEdep);
+
+  B1StepOutput* stepOutput = fRunAction->GetStepOutput();
+  if ( stepOutput->WritesEvents() ) {
+    stepOutput->GetEventOutput()->Write(fSummary);
+  }
 //  G4cout << G4endl << "End event" << G4endl ;
 }
 
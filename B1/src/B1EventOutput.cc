@@ -0,0 +1,180 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1EventOutput.cc
+/// \brief Implementation of the B1EventOutput class
+
+#include "B1EventOutput.hh"
+#include "B1TextStepWriter.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+
+#include <cstdio>
+#include <iomanip>
+
+using std::setw;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventOutput::B1EventOutput()
+: fRunID(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1EventOutput::~B1EventOutput()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1EventOutput::GetShardName(G4int threadID) const
+{
+  G4String name = fDirectory + "events_r";
+  name.append(std::to_string(fRunID));
+  name.append("_t");
+  name.append(std::to_string(threadID));
+  name.append(".dat");
+  return name;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventOutput::BeginOfRun(G4int runID, const G4String& directory)
+{
+  Close();
+  fRunID = runID;
+  fDirectory = directory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventOutput::EndOfRun(G4bool merge)
+{
+  Close();
+
+  // workers have closed their files before the master ends its run
+  if ( G4Threading::IsMultithreadedApplication() &&
+       G4Threading::IsMasterThread() && merge ) Merge();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventOutput::Open(const B1EventSummary& summary)
+{
+  G4String name;
+  if ( G4Threading::IsMultithreadedApplication() ) {
+    name = GetShardName(G4Threading::G4GetThreadId());
+  }
+  else {
+    name = fDirectory + "events_";
+    name.append(std::to_string(fRunID));
+    name.append(".dat");
+  }
+
+  fFile.open(name);
+  if ( ! fFile.is_open() ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open output file " << name;
+    G4Exception("B1EventOutput::Open()", "MyCode0003", FatalException, msg);
+    return;
+  }
+
+  fFile << "EventID/I:eventSeed/L";
+  for ( G4int i = 0; i < summary.nofVolumes; ++i ) {
+    fFile << ":edep_v" << i << "_keV/D"
+          << ":nSteps_v" << i << "/I"
+          << ":Ein_v" << i << "_keV/D"
+          << ":Eout_v" << i << "_keV/D";
+  }
+  fFile << ":stopVolume/I:stopx_um/D:stopy_um/D:stopz_um/D" << '\n';
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventOutput::Close()
+{
+  if ( fFile.is_open() ) fFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventOutput::Write(const B1EventSummary& summary)
+{
+  if ( ! fFile.is_open() ) Open(summary);
+
+  fFile << " " << setw(5) << summary.eventID << " "
+        << " " << setw(20) << summary.eventSeed << " ";
+  for ( G4int i = 0; i < summary.nofVolumes; ++i ) {
+    fFile << " " << setw(10) << summary.edep[i] << " "
+          << " " << setw(10) << summary.nofSteps[i] << " "
+          << " " << setw(10) << summary.entryEnergy[i] << " "
+          << " " << setw(10) << summary.exitEnergy[i] << " ";
+  }
+  fFile << " " << setw(10) << summary.stopVolume << " "
+        << " " << setw(10) << summary.stopX << " "
+        << " " << setw(10) << summary.stopY << " "
+        << " " << setw(10) << summary.stopZ << " " << '\n';
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1EventOutput::Merge()
+{
+  const G4int nofThreads = G4RunManager::GetRunManager()->GetNumberOfThreads();
+
+  std::vector<G4String> shards;
+  for ( G4int threadID = 0; threadID < nofThreads; ++threadID ) {
+    G4String shardName = GetShardName(threadID);
+    std::ifstream shard(shardName);
+    if ( shard.is_open() ) shards.push_back(shardName);
+  }
+  if ( shards.empty() ) return;
+
+  G4String mergedName = fDirectory + "events_";
+  mergedName.append(std::to_string(fRunID));
+  mergedName.append(".dat");
+
+  // the files have the single line header of the text step files
+  B1TextStepWriter writer((B1StepSchema()));
+  std::vector<G4long> offsetShifts;
+  if ( ! writer.MergeFiles(shards, mergedName, offsetShifts) ) {
+    G4ExceptionDescription msg;
+    msg << "Merging of the event summaries into " << mergedName
+        << " failed, the shards are kept.";
+    G4Exception("B1EventOutput::Merge()", "MyCode0004", JustWarning, msg);
+    return;
+  }
+
+  for ( std::size_t i = 0; i < shards.size(); ++i ) {
+    std::remove(shards[i].c_str());
+  }
+  G4cout << "Event summaries merged into " << mergedName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
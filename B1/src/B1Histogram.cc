@@ -0,0 +1,118 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1Histogram.cc
+/// \brief Implementation of the B1Histogram class
+
+#include "B1Histogram.hh"
+
+#include <utility>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Histogram::B1Histogram(const G4String& name, const G4String& title,
+                         G4int nx, G4double xmin, G4double xmax)
+: fName(name),
+  fTitle(title),
+  fNx(nx),
+  fXmin(xmin),
+  fXmax(xmax),
+  fNy(0),
+  fYmin(0.),
+  fYmax(0.),
+  fEntries(0.),
+  fSumW(nx+2, 0.),
+  fSumW2(nx+2, 0.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1Histogram::B1Histogram(const G4String& name, const G4String& title,
+                         G4int nx, G4double xmin, G4double xmax,
+                         G4int ny, G4double ymin, G4double ymax)
+: fName(name),
+  fTitle(title),
+  fNx(nx),
+  fXmin(xmin),
+  fXmax(xmax),
+  fNy(ny),
+  fYmin(ymin),
+  fYmax(ymax),
+  fEntries(0.),
+  fSumW((nx+2)*(ny+2), 0.),
+  fSumW2((nx+2)*(ny+2), 0.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Histogram::FillRange(G4double x1, G4double x2, G4double weight)
+{
+  if ( x2 < x1 ) std::swap(x1, x2);
+
+  G4int first = FindBin(x1, fNx, fXmin, fXmax);
+  G4int last  = FindBin(x2, fNx, fXmin, fXmax);
+  fEntries += 1.;
+  if ( first == last ) {
+    fSumW[first]  += weight;
+    fSumW2[first] += weight*weight;
+    return;
+  }
+
+  // the underflow can only be the first bin and the overflow the last one
+  G4double density = weight/(x2 - x1);
+  G4double width = (fXmax - fXmin)/fNx;
+  for ( G4int bin = first; bin <= last; ++bin ) {
+    G4double low  = ( bin == first ) ? x1 : fXmin + (bin-1)*width;
+    G4double high = ( bin == last )  ? x2 : fXmin + bin*width;
+    G4double binWeight = density*(high - low);
+    fSumW[bin]  += binWeight;
+    fSumW2[bin] += binWeight*binWeight;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Histogram::Add(const B1Histogram& other)
+{
+  for ( std::size_t i = 0; i < fSumW.size(); ++i ) {
+    fSumW[i]  += other.fSumW[i];
+    fSumW2[i] += other.fSumW2[i];
+  }
+  fEntries += other.fEntries;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1Histogram::Reset()
+{
+  for ( std::size_t i = 0; i < fSumW.size(); ++i ) {
+    fSumW[i]  = 0.;
+    fSumW2[i] = 0.;
+  }
+  fEntries = 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
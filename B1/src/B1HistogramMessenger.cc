@@ -0,0 +1,217 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HistogramMessenger.cc
+/// \brief Implementation of the B1HistogramMessenger class
+
+#include "B1HistogramMessenger.hh"
+#include "B1HistogramSet.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+namespace
+{
+  const char* const kQuantityCandidates
+    = "x y z localz ke edep steplen time";
+
+  void SetAxisParameters(G4UIcommand* command, const char* axis)
+  {
+    G4String prefix(axis);
+    G4UIparameter* nbinsPrm = new G4UIparameter((prefix + "nbins").c_str(),'i',false);
+    nbinsPrm->SetParameterRange((prefix + "nbins>0").c_str());
+    command->SetParameter(nbinsPrm);
+    command->SetParameter(new G4UIparameter((prefix + "min").c_str(),'d',false));
+    command->SetParameter(new G4UIparameter((prefix + "max").c_str(),'d',false));
+  }
+
+  void SetWeightParameters(G4UIcommand* command)
+  {
+    G4UIparameter* weightPrm = new G4UIparameter("weight",'s',true);
+    weightPrm->SetParameterCandidates("edep count");
+    weightPrm->SetDefaultValue("edep");
+    command->SetParameter(weightPrm);
+    G4UIparameter* volumePrm = new G4UIparameter("volumeID",'i',true);
+    volumePrm->SetParameterRange("volumeID>=-1");
+    volumePrm->SetDefaultValue(-1);
+    command->SetParameter(volumePrm);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HistogramMessenger::B1HistogramMessenger(B1HistogramSet* histograms)
+: G4UImessenger(),
+  fHistograms(histograms),
+  fHistoDirectory(0),
+  fAdd1DCmd(0),
+  fAdd2DCmd(0),
+  fDepthCmd(0),
+  fFormatCmd(0),
+  fClearCmd(0)
+{
+  fHistoDirectory = new G4UIdirectory("/B1/histo/");
+  fHistoDirectory->SetGuidance("Step histograms filled during the run");
+
+  fAdd1DCmd = new G4UIcommand("/B1/histo/add1D",this);
+  fAdd1DCmd->SetGuidance("Book a 1D histogram of a step quantity:");
+  fAdd1DCmd->SetGuidance("x y z localz (um), ke edep (keV), steplen (um), time (ns).");
+  fAdd1DCmd->SetGuidance("The steps are weighted with their edep (keV) or counted,");
+  fAdd1DCmd->SetGuidance("in the given volume ID only, or in all volumes (-1).");
+  G4UIparameter* namePrm = new G4UIparameter("name",'s',false);
+  fAdd1DCmd->SetParameter(namePrm);
+  G4UIparameter* xPrm = new G4UIparameter("x",'s',false);
+  xPrm->SetParameterCandidates(kQuantityCandidates);
+  fAdd1DCmd->SetParameter(xPrm);
+  SetAxisParameters(fAdd1DCmd, "x");
+  SetWeightParameters(fAdd1DCmd);
+  fAdd1DCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fAdd2DCmd = new G4UIcommand("/B1/histo/add2D",this);
+  fAdd2DCmd->SetGuidance("Book a 2D histogram of two step quantities,");
+  fAdd2DCmd->SetGuidance("see /B1/histo/add1D.");
+  namePrm = new G4UIparameter("name",'s',false);
+  fAdd2DCmd->SetParameter(namePrm);
+  xPrm = new G4UIparameter("x",'s',false);
+  xPrm->SetParameterCandidates(kQuantityCandidates);
+  fAdd2DCmd->SetParameter(xPrm);
+  G4UIparameter* yPrm = new G4UIparameter("y",'s',false);
+  yPrm->SetParameterCandidates(kQuantityCandidates);
+  fAdd2DCmd->SetParameter(yPrm);
+  SetAxisParameters(fAdd2DCmd, "x");
+  SetAxisParameters(fAdd2DCmd, "y");
+  SetWeightParameters(fAdd2DCmd);
+  fAdd2DCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDepthCmd = new G4UIcommand("/B1/histo/depth",this);
+  fDepthCmd->SetGuidance("Score the edep in a volume ID by local z, in nbins");
+  fDepthCmd->SetGuidance("over [min, max], or over the full volume thickness");
+  fDepthCmd->SetGuidance("if no range is given; nbins = 0 removes the profile.");
+  fDepthCmd->SetGuidance("The geometry is not sliced: the edep of a step is");
+  fDepthCmd->SetGuidance("spread between its pre- and post-step depths.");
+  G4UIparameter* volumePrm = new G4UIparameter("volumeID",'i',false);
+  volumePrm->SetParameterRange("volumeID>=1");
+  fDepthCmd->SetParameter(volumePrm);
+  G4UIparameter* nbinsPrm = new G4UIparameter("nbins",'i',false);
+  nbinsPrm->SetParameterRange("nbins>=0");
+  fDepthCmd->SetParameter(nbinsPrm);
+  G4UIparameter* minPrm = new G4UIparameter("min",'d',true);
+  minPrm->SetDefaultValue(0.);
+  fDepthCmd->SetParameter(minPrm);
+  G4UIparameter* maxPrm = new G4UIparameter("max",'d',true);
+  maxPrm->SetDefaultValue(0.);
+  fDepthCmd->SetParameter(maxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("um");
+  fDepthCmd->SetParameter(unitPrm);
+  fDepthCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFormatCmd = new G4UIcmdWithAString("/B1/histo/format",this);
+  fFormatCmd->SetGuidance("Select the histogram file format:");
+  fFormatCmd->SetGuidance("root (histos_<runID>.root, if built with ROOT)");
+  fFormatCmd->SetGuidance("or csv (one histos_<runID>_<name>.csv per histogram).");
+  fFormatCmd->SetParameterName("format",false);
+  fFormatCmd->SetCandidates("root csv");
+  fFormatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/B1/histo/clear",this);
+  fClearCmd->SetGuidance("Remove all the histograms.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HistogramMessenger::~B1HistogramMessenger()
+{
+  delete fAdd1DCmd;
+  delete fAdd2DCmd;
+  delete fDepthCmd;
+  delete fFormatCmd;
+  delete fClearCmd;
+  delete fHistoDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fAdd1DCmd || command == fAdd2DCmd ) {
+    G4bool is2D = ( command == fAdd2DCmd );
+    std::istringstream is(newValue);
+    G4String name, xKey, yKey, weight;
+    G4int nx, ny = 0, volumeID;
+    G4double xmin, xmax, ymin = 0., ymax = 0.;
+    is >> name >> xKey;
+    if ( is2D ) is >> yKey;
+    is >> nx >> xmin >> xmax;
+    if ( is2D ) is >> ny >> ymin >> ymax;
+    is >> weight >> volumeID;
+
+    // the keys are checked by the parameter candidates
+    B1HistogramSet::Quantity x, y;
+    B1HistogramSet::GetQuantity(xKey, x);
+    if ( ! is2D || ! B1HistogramSet::GetQuantity(yKey, y) ) y = x;
+    if ( xmax <= xmin || ( is2D && ymax <= ymin ) ) {
+      G4ExceptionDescription msg;
+      msg << "Empty axis range, histogram " << name << " is not booked.";
+      G4Exception("B1HistogramMessenger::SetNewValue()", "MyCode0006",
+                  JustWarning, msg);
+      return;
+    }
+
+    if ( is2D ) {
+      fHistograms->Add2D(name, x, y, nx, xmin, xmax, ny, ymin, ymax,
+                         weight == "edep", volumeID);
+    }
+    else {
+      fHistograms->Add1D(name, x, nx, xmin, xmax, weight == "edep", volumeID);
+    }
+  }
+  else if ( command == fDepthCmd ) {
+    std::istringstream is(newValue);
+    G4int volumeID, nbins;
+    G4double min, max;
+    G4String unit;
+    is >> volumeID >> nbins >> min >> max >> unit;
+    // the histogram axes are in um
+    G4double value = G4UIcommand::ValueOf(unit)/micrometer;
+    fHistograms->SetDepthBinning(volumeID, nbins, min*value, max*value);
+  }
+  else if ( command == fFormatCmd ) {
+    fHistograms->SetFormat(newValue);
+  }
+  else if ( command == fClearCmd ) {
+    fHistograms->Clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
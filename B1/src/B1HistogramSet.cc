@@ -0,0 +1,495 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1HistogramSet.cc
+/// \brief Implementation of the B1HistogramSet class
+
+#include "B1HistogramSet.hh"
+#include "B1HistogramMessenger.hh"
+#include "B1StepContext.hh"
+
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4VSolid.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <fstream>
+
+#ifdef B1_USE_ROOT
+#include <TFile.h>
+#include <TH1D.h>
+#include <TH2D.h>
+#endif
+
+namespace
+{
+  // indexed by B1HistogramSet::Quantity
+  const char* const kQuantityKeys[] = {
+    "x", "y", "z", "localz", "ke", "edep", "steplen", "time"
+  };
+  const char* const kQuantityUnits[] = {
+    "um", "um", "um", "um", "keV", "keV", "um", "ns"
+  };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HistogramSet::B1HistogramSet(const G4String& name)
+: G4VAccumulable(name),
+  fMessenger(0),
+  fStepContext(0),
+  fQuantities(0),
+  fHasDepth(false),
+#ifdef B1_USE_ROOT
+  fFormat("root")
+#else
+  fFormat("csv")
+#endif
+{
+  fMessenger = new B1HistogramMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1HistogramSet::~B1HistogramSet()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1HistogramSet::GetQuantity(const G4String& key, Quantity& quantity)
+{
+  for ( G4int i = 0; i < kNofQuantities; ++i ) {
+    if ( key == kQuantityKeys[i] ) {
+      quantity = Quantity(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1HistogramSet::CanAdd(const G4String& name) const
+{
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    if ( fHistograms[i].GetName() == name ) {
+      G4ExceptionDescription msg;
+      msg << "Histogram " << name << " is already defined.";
+      G4Exception("B1HistogramSet::CanAdd()", "MyCode0006", JustWarning, msg);
+      return false;
+    }
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1HistogramSet::GetTitle(Quantity x, Quantity y, G4bool is2D,
+                                  G4bool edepWeight, G4int volumeID) const
+{
+  // ROOT title convention: "title;x axis;y axis"
+  G4String title = edepWeight ? "edep" : "steps";
+  if ( volumeID >= 0 ) {
+    title.append(" in volume ");
+    title.append(std::to_string(volumeID));
+  }
+  G4String xAxis = G4String(kQuantityKeys[x]) + " [" + kQuantityUnits[x] + "]";
+  G4String yAxis = G4String(kQuantityKeys[y]) + " [" + kQuantityUnits[y] + "]";
+  if ( is2D ) {
+    return title + ";" + xAxis + ";" + yAxis;
+  }
+  return title + ";" + xAxis + ";" + (edepWeight ? "edep [keV]" : "steps");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Add1D(const G4String& name, Quantity x,
+                           G4int nx, G4double xmin, G4double xmax,
+                           G4bool edepWeight, G4int volumeID)
+{
+  if ( ! CanAdd(name) ) return;
+
+  fHistograms.push_back(
+    B1Histogram(name, GetTitle(x, x, false, edepWeight, volumeID),
+                nx, xmin, xmax));
+  Binning binning = { x, x, edepWeight, volumeID, false, false, false };
+  fBinnings.push_back(binning);
+  UpdateQuantities();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Add2D(const G4String& name, Quantity x, Quantity y,
+                           G4int nx, G4double xmin, G4double xmax,
+                           G4int ny, G4double ymin, G4double ymax,
+                           G4bool edepWeight, G4int volumeID)
+{
+  if ( ! CanAdd(name) ) return;
+
+  fHistograms.push_back(
+    B1Histogram(name, GetTitle(x, y, true, edepWeight, volumeID),
+                nx, xmin, xmax, ny, ymin, ymax));
+  Binning binning = { x, y, edepWeight, volumeID, false, false, false };
+  fBinnings.push_back(binning);
+  UpdateQuantities();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::SetDepthBinning(G4int volumeID, G4int nbins,
+                                     G4double min, G4double max)
+{
+  if ( volumeID < 1 || volumeID >= B1StepContext::kMaxNofVolumes ) {
+    G4ExceptionDescription msg;
+    msg << "No scoring volume " << volumeID << ", depth binning ignored.";
+    G4Exception("B1HistogramSet::SetDepthBinning()", "MyCode0006",
+                JustWarning, msg);
+    return;
+  }
+  AddDepthBinning(volumeID, nbins, min, max, false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::AddDepthBinning(G4int volumeID, G4int nbins,
+                                     G4double min, G4double max,
+                                     G4bool fromLayer)
+{
+  G4String name = "depth_";
+  name.append(std::to_string(volumeID));
+
+  // a new binning of the same volume replaces the previous one
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    if ( fHistograms[i].GetName() == name ) {
+      fHistograms.erase(fHistograms.begin() + i);
+      fBinnings.erase(fBinnings.begin() + i);
+      break;
+    }
+  }
+
+  if ( nbins > 0 ) {
+    G4bool fullDepth = ( min == max );
+    if ( fullDepth ) {
+      // the range is set in BeginOfRun()
+      min = 0.;
+      max = 1.;
+    }
+    G4String title = "edep in volume ";
+    title.append(std::to_string(volumeID));
+    title.append(" by depth;localz [um];edep [keV]");
+    fHistograms.push_back(B1Histogram(name, title, nbins, min, max));
+    Binning binning
+      = { kLocalZ, kLocalZ, true, volumeID, true, fullDepth, fromLayer };
+    fBinnings.push_back(binning);
+  }
+  UpdateQuantities();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::UpdateQuantities()
+{
+  fQuantities = 0;
+  fHasDepth = false;
+  for ( std::size_t i = 0; i < fBinnings.size(); ++i ) {
+    fQuantities |= (1 << fBinnings[i].x) | (1 << fBinnings[i].y);
+    if ( fBinnings[i].depth ) fHasDepth = true;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Clear()
+{
+  fHistograms.clear();
+  fBinnings.clear();
+  UpdateQuantities();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::BeginOfRun(const B1StepContext& context)
+{
+  fStepContext = &context;
+
+  // the layer depth bins may have changed since the previous run
+  for ( std::size_t i = fBinnings.size(); i > 0; --i ) {
+    if ( ! fBinnings[i-1].fromLayer ) continue;
+    fHistograms.erase(fHistograms.begin() + (i-1));
+    fBinnings.erase(fBinnings.begin() + (i-1));
+  }
+  // the layers are the volume IDs 1 to N, the envelope is N+1
+  for ( G4int id = 1; id < context.GetNofVolumes() - 1; ++id ) {
+    if ( context.GetNofDepthBins(id) == 0 ) continue;
+    G4String name = "depth_";
+    name.append(std::to_string(id));
+    G4bool booked = false;
+    for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+      if ( fHistograms[i].GetName() == name ) booked = true;
+    }
+    if ( ! booked ) {
+      AddDepthBinning(id, context.GetNofDepthBins(id), 0., 0., true);
+    }
+  }
+  UpdateQuantities();
+
+  // the geometry may have been rebuilt since the previous run
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    const Binning& binning = fBinnings[i];
+    if ( ! binning.fullDepth ) continue;
+
+    G4LogicalVolume* volume = context.GetVolume(binning.volumeID);
+    if ( ! volume ) continue;
+
+    G4ThreeVector pMin, pMax;
+    volume->GetSolid()->BoundingLimits(pMin, pMax);
+    const B1Histogram& histo = fHistograms[i];
+    fHistograms[i] = B1Histogram(histo.GetName(), histo.GetTitle(),
+                                 histo.GetNbinsX(),
+                                 pMin.z()/micrometer, pMax.z()/micrometer);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Fill(const G4Step* step, G4int volumeID)
+{
+  if ( fHistograms.empty() ) return;
+
+  // compute only the quantities used by the booked histograms
+  G4double values[kNofQuantities];
+  G4double preLocalZ = 0.;
+  const G4StepPoint* poststep = step->GetPostStepPoint();
+  if ( fQuantities & ((1 << kX) | (1 << kY) | (1 << kZ)) ) {
+    const G4ThreeVector& pos = poststep->GetPosition();
+    values[kX] = pos.x()/micrometer;
+    values[kY] = pos.y()/micrometer;
+    values[kZ] = pos.z()/micrometer;
+  }
+  if ( fQuantities & (1 << kLocalZ) ) {
+    const G4StepPoint* prestep = step->GetPreStepPoint();
+    // in the frame of the foil, not of its slice
+    const G4AffineTransform& transform
+      = fStepContext->GetLocalTransform(prestep->GetTouchable(), volumeID);
+    values[kLocalZ]
+      = transform.TransformPoint(poststep->GetPosition()).z()/micrometer;
+    if ( fHasDepth ) {
+      preLocalZ
+        = transform.TransformPoint(prestep->GetPosition()).z()/micrometer;
+    }
+  }
+  if ( fQuantities & (1 << kKinEnergy) ) {
+    values[kKinEnergy] = step->GetTrack()->GetKineticEnergy()/keV;
+  }
+  values[kEdep] = step->GetTotalEnergyDeposit()/keV;
+  if ( fQuantities & (1 << kStepLength) ) {
+    values[kStepLength] = step->GetStepLength()/micrometer;
+  }
+  if ( fQuantities & (1 << kTime) ) {
+    values[kTime] = poststep->GetGlobalTime()/ns;
+  }
+
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    const Binning& binning = fBinnings[i];
+    if ( binning.volumeID >= 0 && binning.volumeID != volumeID ) continue;
+
+    G4double weight = 1.;
+    if ( binning.edepWeight ) {
+      // steps without deposit would only add empty entries
+      if ( values[kEdep] <= 0. ) continue;
+      weight = values[kEdep];
+    }
+
+    if ( binning.depth ) {
+      fHistograms[i].FillRange(preLocalZ, values[kLocalZ], weight);
+    }
+    else if ( fHistograms[i].GetDimension() == 1 ) {
+      fHistograms[i].Fill(values[binning.x], weight);
+    }
+    else {
+      fHistograms[i].Fill(values[binning.x], values[binning.y], weight);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Merge(const G4VAccumulable& other)
+{
+  const B1HistogramSet& otherSet
+    = static_cast<const B1HistogramSet&>(other);
+
+  // the /B1/histo/ commands are broadcast, so all the threads book the
+  // same histograms in the same order
+  if ( otherSet.fHistograms.size() != fHistograms.size() ) {
+    G4ExceptionDescription msg;
+    msg << "The worker histograms differ from the master ones, "
+        << "they are not merged.";
+    G4Exception("B1HistogramSet::Merge()", "MyCode0004", JustWarning, msg);
+    return;
+  }
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    fHistograms[i].Add(otherSet.fHistograms[i]);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Reset()
+{
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    fHistograms[i].Reset();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::Write(G4int runID, const G4String& directory) const
+{
+  if ( fHistograms.empty() ) return;
+
+#ifdef B1_USE_ROOT
+  if ( fFormat == "root" ) {
+    WriteRoot(runID, directory);
+    return;
+  }
+#endif
+  WriteCsv(runID, directory);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1HistogramSet::WriteCsv(G4int runID, const G4String& directory) const
+{
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    const B1Histogram& histo = fHistograms[i];
+    G4String name = directory + "histos_";
+    name.append(std::to_string(runID));
+    name.append("_");
+    name.append(histo.GetName());
+    name.append(".csv");
+
+    std::ofstream file(name);
+    if ( ! file ) {
+      G4ExceptionDescription msg;
+      msg << "Cannot open output file " << name;
+      G4Exception("B1HistogramSet::WriteCsv()", "MyCode0003",
+                  JustWarning, msg);
+      continue;
+    }
+
+    // the bins 0 and n+1 are the underflow and the overflow
+    G4int nx = histo.GetNbinsX();
+    G4double dx = (histo.GetXmax() - histo.GetXmin())/nx;
+    file << "# " << histo.GetName() << ": " << histo.GetTitle() << "\n"
+         << "# entries " << histo.GetEntries() << "\n";
+    if ( histo.GetDimension() == 1 ) {
+      file << "bin,xlow,xhigh,content,error\n";
+      for ( G4int ix = 0; ix <= nx+1; ++ix ) {
+        file << ix << ","
+             << histo.GetXmin() + (ix-1)*dx << ","
+             << histo.GetXmin() + ix*dx << ","
+             << histo.GetBinContent(ix) << ","
+             << std::sqrt(histo.GetBinError2(ix)) << "\n";
+      }
+    }
+    else {
+      G4int ny = histo.GetNbinsY();
+      G4double dy = (histo.GetYmax() - histo.GetYmin())/ny;
+      file << "binx,biny,xlow,xhigh,ylow,yhigh,content,error\n";
+      for ( G4int iy = 0; iy <= ny+1; ++iy ) {
+        for ( G4int ix = 0; ix <= nx+1; ++ix ) {
+          file << ix << "," << iy << ","
+               << histo.GetXmin() + (ix-1)*dx << ","
+               << histo.GetXmin() + ix*dx << ","
+               << histo.GetYmin() + (iy-1)*dy << ","
+               << histo.GetYmin() + iy*dy << ","
+               << histo.GetBinContent(ix, iy) << ","
+               << std::sqrt(histo.GetBinError2(ix, iy)) << "\n";
+        }
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifdef B1_USE_ROOT
+
+void B1HistogramSet::WriteRoot(G4int runID, const G4String& directory) const
+{
+  G4String name = directory + "histos_";
+  name.append(std::to_string(runID));
+  name.append(".root");
+
+  TFile* file = TFile::Open(name.c_str(), "RECREATE");
+  if ( ! file || file->IsZombie() ) {
+    delete file;
+    G4ExceptionDescription msg;
+    msg << "Cannot open output file " << name;
+    G4Exception("B1HistogramSet::WriteRoot()", "MyCode0003",
+                JustWarning, msg);
+    return;
+  }
+
+  for ( std::size_t i = 0; i < fHistograms.size(); ++i ) {
+    const B1Histogram& histo = fHistograms[i];
+    G4int nx = histo.GetNbinsX();
+    G4int ny = histo.GetNbinsY();
+    TH1* th = 0;
+    if ( histo.GetDimension() == 1 ) {
+      th = new TH1D(histo.GetName().c_str(), histo.GetTitle().c_str(),
+                    nx, histo.GetXmin(), histo.GetXmax());
+    }
+    else {
+      th = new TH2D(histo.GetName().c_str(), histo.GetTitle().c_str(),
+                    nx, histo.GetXmin(), histo.GetXmax(),
+                    ny, histo.GetYmin(), histo.GetYmax());
+    }
+    // same bin numbering, under- and overflow included
+    for ( G4int iy = 0; iy <= (ny > 0 ? ny+1 : 0); ++iy ) {
+      for ( G4int ix = 0; ix <= nx+1; ++ix ) {
+        G4int bin = ( ny > 0 ) ? th->GetBin(ix, iy) : ix;
+        th->SetBinContent(bin, histo.GetBinContent(ix, iy));
+        th->SetBinError(bin, std::sqrt(histo.GetBinError2(ix, iy)));
+      }
+    }
+    th->SetEntries(histo.GetEntries());
+    th->SetDirectory(file);
+  }
+
+  // the histograms are owned and deleted by the file
+  file->Write();
+  file->Close();
+  delete file;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
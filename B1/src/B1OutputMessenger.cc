@@ -0,0 +1,226 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1OutputMessenger.cc
+/// \brief Implementation of the B1OutputMessenger class
+
+#include "B1OutputMessenger.hh"
+#include "B1StepOutput.hh"
+#include "B1StepSchema.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1OutputMessenger::B1OutputMessenger(B1StepOutput* output)
+: G4UImessenger(),
+  fStepOutput(output),
+  fOutputDirectory(0),
+  fModeCmd(0),
+  fFormatCmd(0),
+  fColumnsCmd(0),
+  fBlockSizeCmd(0),
+  fMergeCmd(0),
+  fAsyncCmd(0),
+  fNofBuffersCmd(0),
+  fMaxEventsCmd(0),
+  fMaxSizeCmd(0),
+  fMaxTimeCmd(0),
+  fIndexCmd(0),
+  fDirectoryCmd(0)
+{
+  fOutputDirectory = new G4UIdirectory("/B1/output/");
+  fOutputDirectory->SetGuidance("Step output control");
+
+  fModeCmd = new G4UIcmdWithAString("/B1/output/mode",this);
+  fModeCmd->SetGuidance("Select what is written:");
+  fModeCmd->SetGuidance("  steps  : every step, in the run_N step files");
+  fModeCmd->SetGuidance("  events : one summary per event, in events_<runID>.dat");
+  fModeCmd->SetGuidance("  both   : steps and event summaries");
+  fModeCmd->SetParameterName("mode",false);
+  fModeCmd->SetCandidates("steps events both");
+  fModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fFormatCmd = new G4UIcmdWithAString("/B1/output/format",this);
+  fFormatCmd->SetGuidance("Select the format of the run_N step files.");
+  fFormatCmd->SetGuidance("  text   : ASCII columns readable by TTree::ReadFile");
+  fFormatCmd->SetGuidance("  binary : column-blocked records with a");
+  fFormatCmd->SetGuidance("           self-describing header");
+#ifdef B1_USE_ROOT
+  fFormatCmd->SetGuidance("  root   : TTree \"tree\" with the text format branches");
+#endif
+  fFormatCmd->SetParameterName("format",false);
+#ifdef B1_USE_ROOT
+  fFormatCmd->SetCandidates("text binary root");
+#else
+  fFormatCmd->SetCandidates("text binary");
+#endif
+  fFormatCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fColumnsCmd = new G4UIcmdWithAString("/B1/output/columns",this);
+  fColumnsCmd->SetGuidance("Select the columns of the step files, as a comma");
+  fColumnsCmd->SetGuidance("separated list of keys, e.g. edep,ke,pos,localpos,trackid.");
+  fColumnsCmd->SetGuidance("The event ID is always written and the columns keep");
+  fColumnsCmd->SetGuidance("a fixed order; only the selected fields are computed.");
+  fColumnsCmd->SetGuidance("Available keys:");
+  fColumnsCmd->SetGuidance(("  " + B1StepSchema::GetCandidates()).c_str());
+  fColumnsCmd->SetParameterName("columns",false);
+  fColumnsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBlockSizeCmd = new G4UIcmdWithAnInteger("/B1/output/blockSize",this);
+  fBlockSizeCmd->SetGuidance("Set the number of steps buffered per block.");
+  fBlockSizeCmd->SetParameterName("blockSize",false);
+  fBlockSizeCmd->SetRange("blockSize>0");
+  fBlockSizeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMergeCmd = new G4UIcmdWithABool("/B1/output/merge",this);
+  fMergeCmd->SetGuidance("Merge the per-thread shard files at end of run.");
+  fMergeCmd->SetGuidance("If false, the run_r<run>_t<thread>_<k> shards are kept.");
+  fMergeCmd->SetParameterName("merge",true);
+  fMergeCmd->SetDefaultValue(true);
+  fMergeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fAsyncCmd = new G4UIcmdWithABool("/B1/output/async",this);
+  fAsyncCmd->SetGuidance("Write the step blocks from a dedicated thread.");
+  fAsyncCmd->SetParameterName("async",true);
+  fAsyncCmd->SetDefaultValue(true);
+  fAsyncCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNofBuffersCmd = new G4UIcmdWithAnInteger("/B1/output/nofBuffers",this);
+  fNofBuffersCmd->SetGuidance("Set the number of step blocks per thread,");
+  fNofBuffersCmd->SetGuidance("including the one being filled (2 = double buffering).");
+  fNofBuffersCmd->SetGuidance("Tracking waits for the writer when all are in flight.");
+  fNofBuffersCmd->SetParameterName("nofBuffers",false);
+  fNofBuffersCmd->SetRange("nofBuffers>1");
+  fNofBuffersCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxEventsCmd = new G4UIcmdWithAnInteger("/B1/output/maxEventsPerFile",this);
+  fMaxEventsCmd->SetGuidance("Start a new step file after n events per thread.");
+  fMaxEventsCmd->SetGuidance("0 switches the rotation by events off.");
+  fMaxEventsCmd->SetParameterName("maxEvents",false);
+  fMaxEventsCmd->SetRange("maxEvents>=0");
+  fMaxEventsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxSizeCmd = new G4UIcmdWithADouble("/B1/output/maxFileSize",this);
+  fMaxSizeCmd->SetGuidance("Start a new step file when the current one");
+  fMaxSizeCmd->SetGuidance("has reached the given size in MB.");
+  fMaxSizeCmd->SetGuidance("0 switches the rotation by size off.");
+  fMaxSizeCmd->SetParameterName("maxSize",false);
+  fMaxSizeCmd->SetRange("maxSize>=0.");
+  fMaxSizeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/output/maxFileTime",this);
+  fMaxTimeCmd->SetGuidance("Start a new step file when the current one");
+  fMaxTimeCmd->SetGuidance("has been open for the given wall-clock time.");
+  fMaxTimeCmd->SetGuidance("0 switches the rotation by time off.");
+  fMaxTimeCmd->SetParameterName("maxTime",false);
+  fMaxTimeCmd->SetRange("maxTime>=0.");
+  fMaxTimeCmd->SetUnitCategory("Time");
+  fMaxTimeCmd->SetDefaultUnit("s");
+  fMaxTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fIndexCmd = new G4UIcmdWithABool("/B1/output/index",this);
+  fIndexCmd->SetGuidance("Write a run_N.idx file with the offsets and event");
+  fIndexCmd->SetGuidance("ranges of the blocks of each step file.");
+  fIndexCmd->SetParameterName("index",true);
+  fIndexCmd->SetDefaultValue(true);
+  fIndexCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDirectoryCmd = new G4UIcmdWithAString("/B1/output/directory",this);
+  fDirectoryCmd->SetGuidance("Write the step, event and histogram files in this");
+  fDirectoryCmd->SetGuidance("directory, created if needed (\".\" = current directory).");
+  fDirectoryCmd->SetParameterName("directory",false);
+  fDirectoryCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1OutputMessenger::~B1OutputMessenger()
+{
+  delete fModeCmd;
+  delete fFormatCmd;
+  delete fColumnsCmd;
+  delete fBlockSizeCmd;
+  delete fMergeCmd;
+  delete fAsyncCmd;
+  delete fNofBuffersCmd;
+  delete fMaxEventsCmd;
+  delete fMaxSizeCmd;
+  delete fMaxTimeCmd;
+  delete fIndexCmd;
+  delete fDirectoryCmd;
+  delete fOutputDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1OutputMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fModeCmd ) {
+    fStepOutput->SetMode(newValue);
+  }
+  else if ( command == fFormatCmd ) {
+    fStepOutput->SetFormat(newValue);
+  }
+  else if ( command == fColumnsCmd ) {
+    fStepOutput->SetColumns(newValue);
+  }
+  else if ( command == fBlockSizeCmd ) {
+    fStepOutput->SetBlockSize(fBlockSizeCmd->GetNewIntValue(newValue));
+  }
+  else if ( command == fMergeCmd ) {
+    fStepOutput->SetMerge(fMergeCmd->GetNewBoolValue(newValue));
+  }
+  else if ( command == fAsyncCmd ) {
+    fStepOutput->SetAsync(fAsyncCmd->GetNewBoolValue(newValue));
+  }
+  else if ( command == fNofBuffersCmd ) {
+    fStepOutput->SetNofBuffers(fNofBuffersCmd->GetNewIntValue(newValue));
+  }
+  else if ( command == fMaxEventsCmd ) {
+    fStepOutput->SetMaxEventsPerFile(fMaxEventsCmd->GetNewIntValue(newValue));
+  }
+  else if ( command == fMaxSizeCmd ) {
+    fStepOutput->SetMaxFileSize(
+      fMaxSizeCmd->GetNewDoubleValue(newValue)*1024.*1024.);
+  }
+  else if ( command == fMaxTimeCmd ) {
+    fStepOutput->SetMaxFileTime(fMaxTimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if ( command == fIndexCmd ) {
+    fStepOutput->SetIndex(fIndexCmd->GetNewBoolValue(newValue));
+  }
+  else if ( command == fDirectoryCmd ) {
+    fStepOutput->SetDirectory(newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,220 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhysicsTableCache.cc
+/// \brief Implementation of the B1PhysicsTableCache class
+
+#include "B1PhysicsTableCache.hh"
+#include "B1PhysicsTableCacheMessenger.hh"
+
+#include "G4VUserPhysicsList.hh"
+#include "G4StateManager.hh"
+#include "G4Material.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Version.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace
+{
+  // written last: the tables of a directory with it are complete
+  const char* kDescriptionFile = "tables.txt";
+
+  // FNV-1a: the same key for the same description in all the builds
+  G4String Hash(const G4String& text)
+  {
+    unsigned long long hash = 14695981039346656037ULL;
+    for ( std::size_t i = 0; i < text.size(); ++i ) {
+      hash ^= static_cast<unsigned char>(text[i]);
+      hash *= 1099511628211ULL;
+    }
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return os.str();
+  }
+
+  G4bool FileExists(const G4String& fileName)
+  {
+    std::ifstream file(fileName);
+    return file.good();
+  }
+
+  // without a shell, so that the path may hold any character
+  void RemoveDirectory(const G4String& directory)
+  {
+    std::error_code error;
+    std::filesystem::remove_all(directory.c_str(), error);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhysicsTableCache::B1PhysicsTableCache(G4VUserPhysicsList* physicsList,
+                                         const G4String& physicsListName)
+: G4VStateDependent(),
+  fPhysicsList(physicsList),
+  fPhysicsListName(physicsListName),
+  fDirectory("physics_tables"),
+  fIsDone(false),
+  fToBeStored(false),
+  fMessenger(0)
+{
+  const char* envDirectory = std::getenv("B1_PHYSICS_CACHE");
+  if ( envDirectory ) {
+    fDirectory = envDirectory;
+    if ( fDirectory == "none" ) fDirectory = "";
+  }
+
+  fMessenger = new B1PhysicsTableCacheMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhysicsTableCache::~B1PhysicsTableCache()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+  // the tables are built by the first run initialization, Idle -> Init,
+  // and the later ones only update them; /run/initialize does not
+  // build them (PreInit -> Init)
+  G4ApplicationState previousState
+    = G4StateManager::GetStateManager()->GetPreviousState();
+
+  if ( previousState == G4State_Idle && requestedState == G4State_Init ) {
+    BeginOfRunInitialization();
+  }
+  else if ( previousState == G4State_Init && requestedState == G4State_Idle ) {
+    EndOfRunInitialization();
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1PhysicsTableCache::GetDescription() const
+{
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << "Geant4 " << G4VERSION_NUMBER << G4endl;
+  os << "physics list " << fPhysicsListName << G4endl;
+  os << "default cut " << fPhysicsList->GetDefaultCutValue() << G4endl;
+
+  const G4MaterialTable* materials = G4Material::GetMaterialTable();
+  for ( std::size_t i = 0; i < materials->size(); ++i ) {
+    const G4Material* material = (*materials)[i];
+    os << "material " << material->GetName()
+       << " " << material->GetDensity()
+       << " " << material->GetNumberOfElements()
+       << " " << material->GetState() << G4endl;
+  }
+
+  // the regions, in the order of creation, with their cuts for
+  // gamma, e-, e+ and proton; the regions without a root volume, e.g.
+  // of the layers removed from the stack, have no couple
+  G4RegionStore* regionStore = G4RegionStore::GetInstance();
+  for ( std::size_t i = 0; i < regionStore->size(); ++i ) {
+    const G4Region* region = (*regionStore)[i];
+    if ( region->GetNumberOfRootVolumes() == 0 ) continue;
+    os << "region " << region->GetName();
+    const G4ProductionCuts* cuts = region->GetProductionCuts();
+    if ( cuts ) {
+      for ( G4int j = 0; j < 4; ++j ) os << " " << cuts->GetProductionCut(j);
+    }
+    os << G4endl;
+  }
+
+  return os.str();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhysicsTableCache::BeginOfRunInitialization()
+{
+  if ( fIsDone || fDirectory.empty() ) return;
+  fIsDone = true;
+
+  fDescription = GetDescription();
+  fKeyDirectory = fDirectory + "/" + Hash(fDescription);
+
+  if ( FileExists(fKeyDirectory + "/" + kDescriptionFile) ) {
+    // a table which cannot be retrieved is built as usual
+    G4cout << "### Physics tables retrieved from " << fKeyDirectory << G4endl;
+    fPhysicsList->SetPhysicsTableRetrieved(fKeyDirectory);
+  }
+  else {
+    fToBeStored = true;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhysicsTableCache::EndOfRunInitialization()
+{
+  if ( ! fToBeStored ) return;
+  fToBeStored = false;
+
+  std::ostringstream tmpDirectory;
+  tmpDirectory << fKeyDirectory << ".tmp" << getpid();
+  std::error_code error;
+  std::filesystem::create_directories(tmpDirectory.str(), error);
+
+  if ( error || ! fPhysicsList->StorePhysicsTable(tmpDirectory.str()) ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot store the physics tables in " << tmpDirectory.str();
+    if ( error ) msg << ": " << error.message();
+    G4Exception("B1PhysicsTableCache::EndOfRunInitialization()",
+                "MyCode0003", JustWarning, msg);
+    RemoveDirectory(tmpDirectory.str());
+    return;
+  }
+
+  std::ofstream description(tmpDirectory.str() + "/" + kDescriptionFile);
+  description << fDescription;
+  description.close();
+
+  // another job may have stored the same tables meanwhile
+  if ( std::rename(tmpDirectory.str().c_str(), fKeyDirectory.c_str()) == 0 ) {
+    G4cout << "### Physics tables stored in " << fKeyDirectory << G4endl;
+  }
+  else {
+    RemoveDirectory(tmpDirectory.str());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1PhysicsTableCacheMessenger.cc
+/// \brief Implementation of the B1PhysicsTableCacheMessenger class
+
+#include "B1PhysicsTableCacheMessenger.hh"
+#include "B1PhysicsTableCache.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhysicsTableCacheMessenger::B1PhysicsTableCacheMessenger(
+                                B1PhysicsTableCache* tableCache)
+: G4UImessenger(),
+  fTableCache(tableCache),
+  fPhysDirectory(0),
+  fTableCacheCmd(0)
+{
+  fPhysDirectory = new G4UIdirectory("/B1/phys/");
+  fPhysDirectory->SetGuidance("Physics tables control");
+
+  fTableCacheCmd = new G4UIcmdWithAString("/B1/phys/tableCache",this);
+  fTableCacheCmd->SetGuidance("Set the directory of the physics table cache");
+  fTableCacheCmd->SetGuidance("(default $B1_PHYSICS_CACHE or physics_tables);");
+  fTableCacheCmd->SetGuidance("\"none\" disables it. Used at the first run only.");
+  fTableCacheCmd->SetParameterName("directory",false);
+  fTableCacheCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+  // the tables are built on master
+  fTableCacheCmd->SetToBeBroadcasted(false);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1PhysicsTableCacheMessenger::~B1PhysicsTableCacheMessenger()
+{
+  delete fTableCacheCmd;
+  delete fPhysDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1PhysicsTableCacheMessenger::SetNewValue(G4UIcommand* command,
+                                               G4String newValue)
+{
+  if ( command == fTableCacheCmd ) {
+    fTableCache->SetDirectory( newValue == "none" ? G4String() : newValue );
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
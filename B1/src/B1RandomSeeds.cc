@@ -0,0 +1,132 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RandomSeeds.cc
+/// \brief Implementation of the B1RandomSeeds class
+
+#include "B1RandomSeeds.hh"
+#include "B1RandomSeedsMessenger.hh"
+
+#include "Randomize.hh"
+
+#include <cstdint>
+
+namespace
+{
+  // the SplitMix64 finalizer: consecutive inputs give unrelated outputs
+  std::uint64_t Mix(std::uint64_t x)
+  {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  // a non-zero engine seed below both moduli of Ranecu; MixMax takes any
+  long EngineSeed(std::uint64_t bits)
+  {
+    return 1 + static_cast<long>((bits & 0x7fffffffULL) % 2147483398ULL);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RandomSeeds::B1RandomSeeds()
+: fMessenger(0),
+  fMasterSeed(0),
+  fRunID(0),
+  fEventSeed(0)
+{
+  fMessenger = new B1RandomSeedsMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RandomSeeds::~B1RandomSeeds()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RandomSeeds::SetReplaySeeds(const std::vector<G4long>& seeds)
+{
+  fReplaySeeds = seeds;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4long B1RandomSeeds::EventSeed(G4long masterSeed, G4int runID, G4int eventID)
+{
+  std::uint64_t ids = ( static_cast<std::uint64_t>(static_cast<std::uint32_t>(runID)) << 32 )
+                      | static_cast<std::uint32_t>(eventID);
+  std::uint64_t x = Mix(Mix(static_cast<std::uint64_t>(masterSeed)) ^ ids);
+  return static_cast<G4long>(x >> 2);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RandomSeeds::BeginOfRun(G4int runID, G4bool isMaster)
+{
+  fRunID = runID;
+  fEventSeed = 0;
+
+  if ( ! isMaster ) return;
+
+  G4cout << "Random engine " << G4Random::getTheEngine()->name()
+         << ", master seed " << fMasterSeed;
+  if ( ! fReplaySeeds.empty() ) {
+    G4cout << ", replaying " << fReplaySeeds.size() << " event seeds";
+  }
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RandomSeeds::BeginOfEvent(G4int eventID)
+{
+  if ( eventID >= 0 && eventID < G4int(fReplaySeeds.size()) ) {
+    fEventSeed = fReplaySeeds[eventID];
+  }
+  else {
+    fEventSeed = EventSeed(fMasterSeed, fRunID, eventID);
+  }
+
+  // two 31-bit words of the event seed, the list ended by 0
+  std::uint64_t bits = static_cast<std::uint64_t>(fEventSeed);
+  long seeds[3] = { EngineSeed(bits), EngineSeed(bits >> 31), 0 };
+  G4Random::setTheSeeds(seeds);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RandomSeeds::EndOfRun()
+{
+  // the replayed seeds apply to a single run
+  fReplaySeeds.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
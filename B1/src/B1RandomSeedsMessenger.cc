@@ -0,0 +1,113 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RandomSeedsMessenger.cc
+/// \brief Implementation of the B1RandomSeedsMessenger class
+
+#include "B1RandomSeedsMessenger.hh"
+#include "B1RandomSeeds.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RandomSeedsMessenger::B1RandomSeedsMessenger(B1RandomSeeds* randomSeeds)
+: G4UImessenger(),
+  fRandomSeeds(randomSeeds),
+  fRandomDirectory(0),
+  fMasterSeedCmd(0),
+  fReplayCmd(0)
+{
+  fRandomDirectory = new G4UIdirectory("/B1/random/");
+  fRandomDirectory->SetGuidance("Per-event seeds of the random engine");
+
+  fMasterSeedCmd = new G4UIcmdWithAString("/B1/random/masterSeed",this);
+  fMasterSeedCmd->SetGuidance("Set the seed from which the seed of each event");
+  fMasterSeedCmd->SetGuidance("is derived, with its run and event IDs.");
+  fMasterSeedCmd->SetParameterName("seed",false);
+  fMasterSeedCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fReplayCmd = new G4UIcmdWithAString("/B1/random/replay",this);
+  fReplayCmd->SetGuidance("Seed the events of the next run with the given");
+  fReplayCmd->SetGuidance("event seeds, in order, e.g. those of the event");
+  fReplayCmd->SetGuidance("summaries; the events beyond the list are seeded");
+  fReplayCmd->SetGuidance("from the master seed. \"none\" clears the list.");
+  fReplayCmd->SetParameterName("seeds",false);
+  fReplayCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RandomSeedsMessenger::~B1RandomSeedsMessenger()
+{
+  delete fMasterSeedCmd;
+  delete fReplayCmd;
+  delete fRandomDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RandomSeedsMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  std::istringstream is(newValue);
+  if ( command == fMasterSeedCmd ) {
+    G4long seed = 0;
+    if ( ! ( is >> seed ) ) {
+      G4ExceptionDescription msg;
+      msg << "Invalid master seed \"" << newValue << "\", not changed.";
+      G4Exception("B1RandomSeedsMessenger::SetNewValue()",
+                  "MyCode0009", JustWarning, msg);
+      return;
+    }
+    fRandomSeeds->SetMasterSeed(seed);
+  }
+  else if ( command == fReplayCmd ) {
+    std::vector<G4long> seeds;
+    G4String word;
+    while ( is >> word ) {
+      if ( word == "none" ) {
+        seeds.clear();
+        break;
+      }
+      std::istringstream wordStream(word);
+      G4long seed = 0;
+      if ( ! ( wordStream >> seed ) ) {
+        G4ExceptionDescription msg;
+        msg << "Invalid event seed \"" << word << "\", no seed replayed.";
+        G4Exception("B1RandomSeedsMessenger::SetNewValue()",
+                    "MyCode0009", JustWarning, msg);
+        return;
+      }
+      seeds.push_back(seed);
+    }
+    fRandomSeeds->SetReplaySeeds(seeds);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
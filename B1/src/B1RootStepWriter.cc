@@ -0,0 +1,150 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1RootStepWriter.cc
+/// \brief Implementation of the B1RootStepWriter class
+
+#ifdef B1_USE_ROOT
+
+#include "B1RootStepWriter.hh"
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TFileMerger.h>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RootStepWriter::B1RootStepWriter(const B1StepSchema& schema)
+: B1StepWriter(schema),
+  fFile(0),
+  fTree(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1RootStepWriter::~B1RootStepWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RootStepWriter::Open(const G4String& fileName)
+{
+  fFile = TFile::Open(fileName.c_str(), "RECREATE", "", kCompression);
+  if ( ! fFile || fFile->IsZombie() ) {
+    delete fFile;
+    fFile = 0;
+    return false;
+  }
+
+  fTree = new TTree("tree", "tree");
+  fTree->SetDirectory(fFile);
+  const std::vector<const B1StepField*>& fields = fSchema.GetFields();
+  for ( std::size_t i = 0; i < fields.size(); ++i ) {
+    const B1StepField& field = *fields[i];
+    G4String leaf = field.name;
+    leaf.append("/");
+    leaf.push_back(field.type);
+    fTree->Branch(field.name, field.Address(fRecord), leaf.c_str());
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RootStepWriter::WriteBlock(const std::vector<B1StepRecord>& records,
+                                  std::size_t nofRecords)
+{
+  IndexBlock(fTree->GetEntries(), records, nofRecords);
+
+  for ( std::size_t i = 0; i < nofRecords; ++i ) {
+    fRecord = records[i];
+    fTree->Fill();
+  }
+  fBytesWritten = fFile->GetBytesWritten();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1RootStepWriter::Close()
+{
+  if ( ! fFile ) return;
+
+  fFile->cd();
+  fTree->Write();
+  // the tree is owned and deleted by the file
+  fFile->Close();
+  delete fFile;
+  fFile = 0;
+  fTree = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RootStepWriter::SkipHeader(std::istream&) const
+{
+  // ROOT files are not concatenated, see MergeFiles()
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1RootStepWriter::MergeFiles(const std::vector<G4String>& inputs,
+                                    const G4String& output,
+                                    std::vector<G4long>& offsetShifts) const
+{
+  offsetShifts.clear();
+
+  TFileMerger merger(kFALSE);
+  if ( ! merger.OutputFile(output.c_str(), "RECREATE", kCompression) ) {
+    return false;
+  }
+
+  // the trees are appended in the order of the inputs, so the index
+  // entry numbers are shifted by the entries of the preceding inputs
+  G4long nofEntries = 0;
+  for ( std::size_t i = 0; i < inputs.size(); ++i ) {
+    if ( ! merger.AddFile(inputs[i].c_str(), kFALSE) ) return false;
+
+    offsetShifts.push_back(nofEntries);
+    TFile* input = TFile::Open(inputs[i].c_str());
+    if ( ! input || input->IsZombie() ) {
+      delete input;
+      return false;
+    }
+    TTree* tree = 0;
+    input->GetObject("tree", tree);
+    if ( tree ) nofEntries += tree->GetEntries();
+    input->Close();
+    delete input;
+  }
+  return merger.Merge();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -30,11 +30,16 @@
 #include "B1RunAction.hh"
 #include "B1PrimaryGeneratorAction.hh"
 #include "B1DetectorConstruction.hh"
+#include "B1StepContext.hh"
+#include "B1StepOutput.hh"
+#include "B1TrackKiller.hh"
+#include "B1RandomSeeds.hh"
 // #include "B1Run.hh"
 
 #include "G4RunManager.hh"
 #include "G4Run.hh"
 #include "G4AccumulableManager.hh"
+#include "G4Threading.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4UnitsTable.hh"
@@ -44,8 +49,13 @@
 
 B1RunAction::B1RunAction()
 : G4UserRunAction(),
-  fEdep(0.),
-  fEdep2(0.)
+  fStepContext(0),
+  fStepOutput(0),
+  fTrackKiller(0),
+  fRandomSeeds(0),
+  fDose("Dose"),
+  fHistograms("Histograms"),
+  fThreadStatistics("ThreadStatistics")
 { 
   // add new units for dose
   // 
@@ -61,53 +71,76 @@ B1RunAction::B1RunAction()
 
   // Register accumulable to the accumulable manager
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
-  accumulableManager->RegisterAccumulable(fEdep);
-  accumulableManager->RegisterAccumulable(fEdep2); 
+  accumulableManager->RegisterAccumulable(&fDose);
+  accumulableManager->RegisterAccumulable(&fHistograms);
+  accumulableManager->RegisterAccumulable(&fThreadStatistics);
+
+  fStepContext = new B1StepContext;
+  fStepOutput = new B1StepOutput;
+  fTrackKiller = new B1TrackKiller("TrackKiller", fStepContext);
+  accumulableManager->RegisterAccumulable(fTrackKiller);
+  fRandomSeeds = new B1RandomSeeds;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1RunAction::~B1RunAction()
-{}
+{
+  delete fRandomSeeds;
+  delete fTrackKiller;
+  delete fStepOutput;
+  delete fStepContext;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1RunAction::BeginOfRunAction(const G4Run*)
+void B1RunAction::BeginOfRunAction(const G4Run* run)
 { 
-  // inform the runManager to save random number seed
+  // no engine status is saved: an event is regenerated from its seed
   G4RunManager::GetRunManager()->SetRandomNumberStore(false);
+  fRandomSeeds->BeginOfRun(run->GetRunID(), IsMaster());
 
   // reset accumulables to their initial values
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Reset();
 
+  // the scoring volumes are looked up once per run, not per step
+  fStepContext->BeginOfRun();
+  fHistograms.BeginOfRun(*fStepContext);
+  fStepOutput->BeginOfRun(run->GetRunID());
+
+  fRunStartTime = std::chrono::steady_clock::now();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void B1RunAction::EndOfRunAction(const G4Run* run)
 {
+  // close the step files; on master, merge the workers' shards
+  fStepOutput->EndOfRun();
+  fRandomSeeds->EndOfRun();
+
   G4int nofEvents = run->GetNumberOfEvent();
-  if (nofEvents == 0) return;
 
-  // Merge accumulables 
+  // the workers without any event are reported too
+  if (!IsMaster()) {
+    std::chrono::duration<G4double> runTime
+      = std::chrono::steady_clock::now() - fRunStartTime;
+    fThreadStatistics.AddRun(G4Threading::G4GetThreadId(), nofEvents,
+                             runTime.count());
+  }
+
+  // Merge accumulables, also from the workers without any event, whose
+  // thread statistics entries are reported on master
   G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
   accumulableManager->Merge();
 
-  // Compute dose = total energy deposit in a run and its variance
-  //
-  G4double edep  = fEdep.GetValue();
-  G4double edep2 = fEdep2.GetValue();
-  
-  G4double rms = edep2 - edep*edep/nofEvents;
-  if (rms > 0.) rms = std::sqrt(rms); else rms = 0.;  
+  if (nofEvents == 0) return;
 
-  const B1DetectorConstruction* detectorConstruction
-   = static_cast<const B1DetectorConstruction*>
-     (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-  G4double mass = detectorConstruction->GetScoringVolume1()->GetMass();
-  G4double dose = edep/mass;
-  G4double rmsDose = rms/mass;
+  // the merged histograms are complete only on master
+  if (IsMaster()) {
+    fHistograms.Write(run->GetRunID(), fStepOutput->GetDirectory());
+  }
 
   // Run conditions
   //  note: There is no primary generator action object for "master"
@@ -141,10 +174,41 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
   G4cout
      << G4endl
      << " The run consists of " << nofEvents << " "<< runCondition
-     << G4endl
-     << " Cumulated dose per run, in scoring volume : " 
-     << G4BestUnit(dose,"Dose") << " rms = " << G4BestUnit(rmsDose,"Dose")
-     << G4endl
+     << G4endl;
+
+  // Compute dose = total energy deposit in a run and its variance,
+  // in each scoring volume (the world is not one)
+  //
+  for (G4int i = 1; i < fStepContext->GetNofVolumes(); ++i) {
+    G4LogicalVolume* volume = fStepContext->GetVolume(i);
+    if (!volume) continue;
+
+    G4double edep  = fDose.GetEdep(i);
+    G4double edep2 = fDose.GetEdep2(i);
+
+    G4double rms = edep2 - edep*edep/nofEvents;
+    if (rms > 0.) rms = std::sqrt(rms); else rms = 0.;
+
+    // mass of the volume material only, without its daughters,
+    // but with its slices
+    G4double mass = volume->GetMass(false, fStepContext->HasSlices(i));
+    G4double dose = edep/mass;
+    G4double rmsDose = rms/mass;
+
+    G4cout
+       << " Cumulated dose per run, in " << volume->GetName()
+       << " (volume " << i << ") : "
+       << G4BestUnit(dose,"Dose") << " rms = " << G4BestUnit(rmsDose,"Dose")
+       << G4endl;
+  }
+
+  // the work saved by the region of interest
+  fTrackKiller->Print();
+
+  // the load balance of the worker threads, on master
+  if (IsMaster()) fThreadStatistics.Print();
+
+  G4cout
      << "------------------------------------------------------------"
      << G4endl
      << G4endl;
@@ -152,10 +216,9 @@ void B1RunAction::EndOfRunAction(const G4Run* run)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void B1RunAction::AddEdep(G4double edep)
+void B1RunAction::AddEdep(const G4double edep[B1DoseAccumulable::kMaxNofVolumes])
 {
-  fEdep  += edep;
-  fEdep2 += edep*edep;
+  fDose.AddEvent(edep);
 }
 
 
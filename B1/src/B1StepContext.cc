@@ -0,0 +1,139 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepContext.cc
+/// \brief Implementation of the B1StepContext class
+
+#include "B1StepContext.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4RunManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+
+#include <cstring>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepContext::B1StepContext()
+: fEventID(0),
+  fNofVolumes(1),
+  fLastParticle(0),
+  fLastParticleID(0)
+{
+  for ( G4int i = 0; i < kMaxNofVolumes; ++i ) {
+    fVolumes[i] = 0;
+    fSliceDepth[i] = 0;
+    fNofDepthBins[i] = 0;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepContext::~B1StepContext()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepContext::BeginOfRun()
+{
+  // the geometry may have been rebuilt since the previous run
+  fVolumeIDs.clear();
+  fNofVolumes = 1;
+  for ( G4int i = 0; i < kMaxNofVolumes; ++i ) {
+    fVolumes[i] = 0;
+    fSliceDepth[i] = 0;
+    fNofDepthBins[i] = 0;
+  }
+
+  const B1DetectorConstruction* detectorConstruction
+    = static_cast<const B1DetectorConstruction*>
+      (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if ( ! detectorConstruction ) return;
+
+  // world = 0, layers = 1 to N, envelope = N+1
+  G4int nofLayers = detectorConstruction->GetNofLayers();
+  fNofVolumes = nofLayers + 2;
+  fVolumeIDs.resize(G4LogicalVolumeStore::GetInstance()->size(), 0);
+  for ( G4int i = 1; i <= nofLayers; ++i ) {
+    fVolumes[i] = detectorConstruction->GetLayerVolume(i);
+    fNofDepthBins[i] = detectorConstruction->GetLayer(i).nofDepthBins;
+  }
+  fVolumes[nofLayers+1] = detectorConstruction->GetScoringVolumeEnv();
+  for ( G4int i = 1; i < fNofVolumes; ++i ) {
+    if ( ! fVolumes[i] ) continue;
+    SetVolumeID(fVolumes[i], i);
+
+    // a replicated daughter is a slice of the volume
+    for ( std::size_t j = 0; j < fVolumes[i]->GetNoDaughters(); ++j ) {
+      G4VPhysicalVolume* daughter = fVolumes[i]->GetDaughter(j);
+      if ( ! daughter->IsReplicated() ) continue;
+      SetVolumeID(daughter->GetLogicalVolume(), i);
+      fSliceDepth[i] = 1;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepContext::SetVolumeID(const G4LogicalVolume* volume, G4int volumeID)
+{
+  std::size_t index = volume->GetInstanceID();
+  if ( index >= fVolumeIDs.size() ) fVolumeIDs.resize(index+1, 0);
+  fVolumeIDs[index] = volumeID;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int B1StepContext::InternParticle(const G4ParticleDefinition* particle)
+{
+  std::map<const G4ParticleDefinition*, G4int>::const_iterator it
+    = fParticleIDs.find(particle);
+  if ( it != fParticleIDs.end() ) return it->second;
+
+  const G4String& name = particle->GetParticleName();
+  if ( name.size() >= std::size_t(B1StepRecord::kParticleNameLength) ) {
+    G4ExceptionDescription msg;
+    msg << "The particle name " << name << " is longer than the "
+        << B1StepRecord::kParticleNameLength-1 << " characters of the"
+        << " particle column, it is written cut.";
+    G4Exception("B1StepContext::InternParticle()",
+                "MyCode0010", JustWarning, msg);
+  }
+
+  ParticleName particleName;
+  std::memset(particleName.name, 0, sizeof(particleName.name));
+  std::strncpy(particleName.name, name.c_str(),
+               B1StepRecord::kParticleNameLength-1);
+
+  G4int particleID = fParticleNames.size();
+  fParticleNames.push_back(particleName);
+  fParticleIDs[particle] = particleID;
+  return particleID;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
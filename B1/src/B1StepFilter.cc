@@ -0,0 +1,164 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepFilter.cc
+/// \brief Implementation of the B1StepFilter class
+
+#include "B1StepFilter.hh"
+#include "B1StepFilterMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4VProcess.hh"
+#include "G4ParticleDefinition.hh"
+
+#include <limits>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepFilter::B1StepFilter()
+: fMessenger(0),
+  fMinEdep(0.),
+  fMinKinEnergy(0.),
+  fMaxKinEnergy(std::numeric_limits<G4double>::max())
+{
+  fMessenger = new B1StepFilterMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepFilter::~B1StepFilter()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepFilter::SetVolumes(const std::vector<G4int>& volumeIDs)
+{
+  fVolumes.clear();
+  for ( std::size_t i = 0; i < volumeIDs.size(); ++i ) {
+    if ( volumeIDs[i] < 0 ) continue;
+    if ( volumeIDs[i] >= G4int(fVolumes.size()) ) {
+      fVolumes.resize(volumeIDs[i]+1, false);
+    }
+    fVolumes[volumeIDs[i]] = true;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepFilter::SetParticles(const std::vector<G4String>& names)
+{
+  fParticleNames = std::set<G4String>(names.begin(), names.end());
+  fParticleCache.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepFilter::SetProcesses(const std::vector<G4String>& names)
+{
+  fProcessNames = std::set<G4String>(names.begin(), names.end());
+  fProcessCache.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepFilter::SetKineticEnergyRange(G4double min, G4double max)
+{
+  fMinKinEnergy = min;
+  fMaxKinEnergy = max;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepFilter::Reset()
+{
+  fVolumes.clear();
+  SetParticles(std::vector<G4String>());
+  SetProcesses(std::vector<G4String>());
+  fMinEdep = 0.;
+  fMinKinEnergy = 0.;
+  fMaxKinEnergy = std::numeric_limits<G4double>::max();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StepFilter::Accept(const G4Step* step, G4int volumeID)
+{
+  if ( ! fVolumes.empty() ) {
+    if ( volumeID < 0 || volumeID >= G4int(fVolumes.size()) ) return false;
+    if ( ! fVolumes[volumeID] ) return false;
+  }
+
+  if ( fMinEdep > 0. && step->GetTotalEnergyDeposit() < fMinEdep ) {
+    return false;
+  }
+
+  const G4Track* track = step->GetTrack();
+  G4double kinEnergy = track->GetKineticEnergy();
+  if ( kinEnergy < fMinKinEnergy || kinEnergy > fMaxKinEnergy ) return false;
+
+  if ( ! fParticleNames.empty() &&
+       ! AcceptParticle(track->GetParticleDefinition()) ) return false;
+
+  if ( ! fProcessNames.empty() &&
+       ! AcceptProcess(step->GetPostStepPoint()->GetProcessDefinedStep()) ) {
+    return false;
+  }
+
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StepFilter::AcceptParticle(const G4ParticleDefinition* particle)
+{
+  std::map<const G4ParticleDefinition*, G4bool>::const_iterator it
+    = fParticleCache.find(particle);
+  if ( it != fParticleCache.end() ) return it->second;
+
+  G4bool accept
+    = ( fParticleNames.count(particle->GetParticleName()) > 0 );
+  fParticleCache[particle] = accept;
+  return accept;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StepFilter::AcceptProcess(const G4VProcess* process)
+{
+  std::map<const G4VProcess*, G4bool>::const_iterator it
+    = fProcessCache.find(process);
+  if ( it != fProcessCache.end() ) return it->second;
+
+  // the limiting process may be undefined, e.g. for a killed track
+  G4bool accept
+    = ( process && fProcessNames.count(process->GetProcessName()) > 0 );
+  fProcessCache[process] = accept;
+  return accept;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
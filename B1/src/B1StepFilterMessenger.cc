@@ -0,0 +1,167 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepFilterMessenger.cc
+/// \brief Implementation of the B1StepFilterMessenger class
+
+#include "B1StepFilterMessenger.hh"
+#include "B1StepFilter.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+namespace
+{
+  // list of words, empty if the list is "all"
+  std::vector<G4String> ToWords(const G4String& value)
+  {
+    std::vector<G4String> words;
+    std::istringstream is(value);
+    G4String word;
+    while ( is >> word ) {
+      if ( word == "all" ) return std::vector<G4String>();
+      words.push_back(word);
+    }
+    return words;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepFilterMessenger::B1StepFilterMessenger(B1StepFilter* filter)
+: G4UImessenger(),
+  fStepFilter(filter),
+  fFilterDirectory(0),
+  fVolumesCmd(0),
+  fParticlesCmd(0),
+  fProcessesCmd(0),
+  fMinEdepCmd(0),
+  fKinEnergyRangeCmd(0),
+  fResetCmd(0)
+{
+  fFilterDirectory = new G4UIdirectory("/B1/filter/");
+  fFilterDirectory->SetGuidance("Selection of the steps written to the output");
+
+  fVolumesCmd = new G4UIcmdWithAString("/B1/filter/volumes",this);
+  fVolumesCmd->SetGuidance("Write only the steps in the given volume IDs");
+  fVolumesCmd->SetGuidance("(0 world, 1 to N layers, N+1 envelope).");
+  fVolumesCmd->SetGuidance("\"all\" removes the selection.");
+  fVolumesCmd->SetParameterName("volumeIDs",false);
+  fVolumesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fParticlesCmd = new G4UIcmdWithAString("/B1/filter/particles",this);
+  fParticlesCmd->SetGuidance("Write only the steps of the given particles.");
+  fParticlesCmd->SetGuidance("\"all\" removes the selection.");
+  fParticlesCmd->SetParameterName("particles",false);
+  fParticlesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fProcessesCmd = new G4UIcmdWithAString("/B1/filter/processes",this);
+  fProcessesCmd->SetGuidance("Write only the steps limited by the given processes.");
+  fProcessesCmd->SetGuidance("\"all\" removes the selection.");
+  fProcessesCmd->SetParameterName("processes",false);
+  fProcessesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMinEdepCmd = new G4UIcmdWithADoubleAndUnit("/B1/filter/minEdep",this);
+  fMinEdepCmd->SetGuidance("Write only the steps depositing at least this energy.");
+  fMinEdepCmd->SetParameterName("minEdep",false);
+  fMinEdepCmd->SetRange("minEdep>=0.");
+  fMinEdepCmd->SetUnitCategory("Energy");
+  fMinEdepCmd->SetDefaultUnit("keV");
+  fMinEdepCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fKinEnergyRangeCmd = new G4UIcommand("/B1/filter/kineticEnergyRange",this);
+  fKinEnergyRangeCmd->SetGuidance("Write only the steps of particles with a");
+  fKinEnergyRangeCmd->SetGuidance("kinetic energy within [min, max].");
+  G4UIparameter* minPrm = new G4UIparameter("min",'d',false);
+  minPrm->SetParameterRange("min>=0.");
+  fKinEnergyRangeCmd->SetParameter(minPrm);
+  G4UIparameter* maxPrm = new G4UIparameter("max",'d',false);
+  maxPrm->SetParameterRange("max>=0.");
+  fKinEnergyRangeCmd->SetParameter(maxPrm);
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("keV");
+  fKinEnergyRangeCmd->SetParameter(unitPrm);
+  fKinEnergyRangeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fResetCmd = new G4UIcmdWithoutParameter("/B1/filter/reset",this);
+  fResetCmd->SetGuidance("Remove all the step selections.");
+  fResetCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepFilterMessenger::~B1StepFilterMessenger()
+{
+  delete fVolumesCmd;
+  delete fParticlesCmd;
+  delete fProcessesCmd;
+  delete fMinEdepCmd;
+  delete fKinEnergyRangeCmd;
+  delete fResetCmd;
+  delete fFilterDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepFilterMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fVolumesCmd ) {
+    std::vector<G4String> words = ToWords(newValue);
+    std::vector<G4int> volumeIDs;
+    for ( std::size_t i = 0; i < words.size(); ++i ) {
+      volumeIDs.push_back(G4UIcommand::ConvertToInt(words[i]));
+    }
+    fStepFilter->SetVolumes(volumeIDs);
+  }
+  else if ( command == fParticlesCmd ) {
+    fStepFilter->SetParticles(ToWords(newValue));
+  }
+  else if ( command == fProcessesCmd ) {
+    fStepFilter->SetProcesses(ToWords(newValue));
+  }
+  else if ( command == fMinEdepCmd ) {
+    fStepFilter->SetMinEdep(fMinEdepCmd->GetNewDoubleValue(newValue));
+  }
+  else if ( command == fKinEnergyRangeCmd ) {
+    std::istringstream is(newValue);
+    G4double min, max;
+    G4String unit;
+    is >> min >> max >> unit;
+    G4double value = G4UIcommand::ValueOf(unit);
+    fStepFilter->SetKineticEnergyRange(min*value, max*value);
+  }
+  else if ( command == fResetCmd ) {
+    fStepFilter->Reset();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
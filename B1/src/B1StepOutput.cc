@@ -0,0 +1,402 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepOutput.cc
+/// \brief Implementation of the B1StepOutput class
+
+#include "B1StepOutput.hh"
+#include "B1OutputMessenger.hh"
+#include "B1StepFilter.hh"
+#include "B1EventOutput.hh"
+#include "B1TextStepWriter.hh"
+#include "B1BinaryStepWriter.hh"
+#include "B1RootStepWriter.hh"
+#include "B1StepWriterThread.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepOutput::B1StepOutput()
+: fMessenger(0),
+  fStepFilter(0),
+  fEventOutput(0),
+  fWriter(0),
+  fWriterThread(0),
+  fFormat("text"),
+  fBlock(4096),
+  fNofRecords(0),
+  fFileCount(0),
+  fRunID(0),
+  fShardCount(0),
+  fMerge(true),
+  fAsync(true),
+  fNofBuffers(4),
+  fIndex(true),
+  fWriteSteps(true),
+  fWriteEvents(false),
+  fMaxEventsPerFile(50000),
+  fMaxFileSize(0.),
+  fMaxFileTime(0.),
+  fNofEventsInFile(0)
+{
+  fMessenger = new B1OutputMessenger(this);
+  fStepFilter = new B1StepFilter;
+  fEventOutput = new B1EventOutput;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepOutput::~B1StepOutput()
+{
+  Close();
+  delete fEventOutput;
+  delete fStepFilter;
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetFormat(const G4String& format)
+{
+  if ( format == fFormat ) return;
+
+  // a new format applies from the next file on
+  Close();
+  fFormat = format;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetColumns(const G4String& columns)
+{
+  B1StepSchema schema(fSchema);
+  if ( ! schema.SetColumns(columns) ) return;
+  if ( schema.GetColumns() == fSchema.GetColumns() ) return;
+
+  // the files have a single header, so the new columns go to a new file
+  Close();
+  fSchema = schema;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetMode(const G4String& mode)
+{
+  // steps, events or both
+  fWriteSteps = ( mode != "events" );
+  fWriteEvents = ( mode != "steps" );
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetBlockSize(G4int blockSize)
+{
+  if ( blockSize < 1 ) return;
+
+  // the buffers of the writer thread have the size of the block
+  Close();
+  fBlock.resize(blockSize);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetAsync(G4bool async)
+{
+  Close();
+  fAsync = async;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetNofBuffers(G4int nofBuffers)
+{
+  if ( nofBuffers < 2 ) return;
+
+  Close();
+  fNofBuffers = nofBuffers;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetIndex(G4bool index)
+{
+  Close();
+  fIndex = index;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::SetDirectory(const G4String& directory)
+{
+  Close();
+  fDirectory = directory;
+  if ( fDirectory == "." ) fDirectory = "";
+  if ( fDirectory.empty() ) return;
+  if ( fDirectory.back() != '/' ) fDirectory.append("/");
+
+  // the workers get the command after the master; without a shell, so
+  // that the path may hold any character
+  if ( G4Threading::IsMasterThread() ) {
+    std::error_code error;
+    std::filesystem::create_directories(fDirectory.c_str(), error);
+    if ( error ) {
+      G4ExceptionDescription msg;
+      msg << "Cannot create the output directory " << fDirectory
+          << ": " << error.message();
+      G4Exception("B1StepOutput::SetDirectory()", "MyCode0003",
+                  JustWarning, msg);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepWriter* B1StepOutput::CreateWriter() const
+{
+  if ( fFormat == "binary" ) return new B1BinaryStepWriter(fSchema);
+#ifdef B1_USE_ROOT
+  if ( fFormat == "root" ) return new B1RootStepWriter(fSchema);
+#endif
+  return new B1TextStepWriter(fSchema);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1StepOutput::GetShardName(G4int threadID, G4int shardIndex) const
+{
+  G4String name = fDirectory + "run_r";
+  name.append(std::to_string(fRunID));
+  name.append("_t");
+  name.append(std::to_string(threadID));
+  name.append("_");
+  name.append(std::to_string(shardIndex));
+  return name;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::BeginOfRun(G4int runID)
+{
+  fRunID = runID;
+  fShardCount = 0;
+  fEventOutput->BeginOfRun(runID, fDirectory);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::EndOfRun()
+{
+  Close();
+
+  // workers have closed their shards before the master ends its run
+  if ( G4Threading::IsMultithreadedApplication() &&
+       G4Threading::IsMasterThread() && fMerge ) Merge();
+
+  fEventOutput->EndOfRun(fMerge);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::BeginOfEvent()
+{
+  if ( ! fWriter ) return;
+
+  // the files are rotated between events, so that an event is never
+  // split across two files
+  G4bool rotate = false;
+  if ( fMaxEventsPerFile > 0 && fNofEventsInFile >= fMaxEventsPerFile ) {
+    rotate = true;
+  }
+  if ( fMaxFileSize > 0. && fWriter->GetBytesWritten() >= fMaxFileSize ) {
+    // the writer thread may still hold up to nofBuffers blocks
+    rotate = true;
+  }
+  if ( fMaxFileTime > 0. ) {
+    std::chrono::duration<G4double> elapsed
+      = std::chrono::steady_clock::now() - fFileOpenTime;
+    if ( elapsed.count()*s >= fMaxFileTime ) rotate = true;
+  }
+
+  // the next file is opened with the next record
+  if ( rotate ) Close();
+  else ++fNofEventsInFile;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::Open()
+{
+  Close();
+
+  fWriter = CreateWriter();
+
+  G4String baseName;
+  if ( G4Threading::IsMultithreadedApplication() ) {
+    baseName = GetShardName(G4Threading::G4GetThreadId(), fShardCount++);
+  }
+  else {
+    baseName = fDirectory + "run_";
+    baseName.append(std::to_string(fFileCount++));
+  }
+  G4String name = baseName + fWriter->GetExtension();
+  if ( ! fWriter->Open(name) ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open output file " << name;
+    G4Exception("B1StepOutput::Open()", "MyCode0003", FatalException, msg);
+  }
+  if ( fIndex && ! fWriter->OpenIndex(baseName + ".idx", name) ) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open index file " << baseName << ".idx";
+    G4Exception("B1StepOutput::Open()", "MyCode0003", JustWarning, msg);
+  }
+
+  // the event in progress is the first one of the file
+  fNofEventsInFile = 1;
+  fFileOpenTime = std::chrono::steady_clock::now();
+
+  if ( fAsync ) {
+    fWriterThread
+      = new B1StepWriterThread(fWriter, fNofBuffers, fBlock.size());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::Close()
+{
+  if ( ! fWriter ) return;
+
+  Flush();
+
+  // writes the blocks still in flight
+  delete fWriterThread;
+  fWriterThread = 0;
+
+  fWriter->Close();
+  fWriter->CloseIndex();
+  delete fWriter;
+  fWriter = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::Merge()
+{
+  B1StepWriter* writer = CreateWriter();
+  const G4String extension = writer->GetExtension();
+  const G4int nofThreads = G4RunManager::GetRunManager()->GetNumberOfThreads();
+
+  // the k-th shards of all workers go to one run_N file; workers
+  // without any step in a run have not produced a shard
+  for ( G4int shardIndex = 0; ; ++shardIndex ) {
+    std::vector<G4String> shards;
+    for ( G4int threadID = 0; threadID < nofThreads; ++threadID ) {
+      G4String shardName = GetShardName(threadID, shardIndex);
+      std::ifstream shard(shardName + extension);
+      if ( shard.is_open() ) shards.push_back(shardName);
+    }
+    if ( shards.empty() ) break;
+
+    std::vector<G4String> shardFiles;
+    for ( std::size_t i = 0; i < shards.size(); ++i ) {
+      shardFiles.push_back(shards[i] + extension);
+    }
+
+    G4String mergedName = fDirectory + "run_";
+    mergedName.append(std::to_string(fFileCount++));
+    std::vector<G4long> offsetShifts;
+    if ( ! writer->MergeFiles(shardFiles, mergedName + extension,
+                              offsetShifts) ) {
+      G4ExceptionDescription msg;
+      msg << "Merging of the step shards into " << mergedName << extension
+          << " failed, the shards are kept.";
+      G4Exception("B1StepOutput::Merge()", "MyCode0004", JustWarning, msg);
+      continue;
+    }
+    if ( fIndex ) {
+      MergeIndex(shards, offsetShifts, mergedName + extension,
+                 mergedName + ".idx");
+    }
+
+    for ( std::size_t i = 0; i < shards.size(); ++i ) {
+      std::remove(shardFiles[i].c_str());
+      std::remove((shards[i] + ".idx").c_str());
+    }
+    G4cout << "Step output merged into " << mergedName << extension << G4endl;
+  }
+
+  delete writer;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::MergeIndex(const std::vector<G4String>& shards,
+                              const std::vector<G4long>& offsetShifts,
+                              const G4String& mergedFile,
+                              const G4String& mergedIndex) const
+{
+  std::ofstream merged(mergedIndex);
+  merged << "# file offset nofSteps firstEventID lastEventID" << '\n';
+
+  for ( std::size_t i = 0; i < shards.size(); ++i ) {
+    std::ifstream index(shards[i] + ".idx");
+    G4String line;
+    while ( std::getline(index, line) ) {
+      if ( line.empty() || line[0] == '#' ) continue;
+
+      std::istringstream fields(line);
+      G4String file;
+      G4long offset;
+      std::size_t nofSteps;
+      G4int firstEventID, lastEventID;
+      if ( ! ( fields >> file >> offset >> nofSteps
+                      >> firstEventID >> lastEventID ) ) continue;
+
+      merged << mergedFile << ' ' << offset + offsetShifts[i] << ' '
+             << nofSteps << ' ' << firstEventID << ' ' << lastEventID << '\n';
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepOutput::Flush()
+{
+  if ( fWriterThread ) fWriterThread->Submit(fBlock, fNofRecords);
+  else if ( fWriter ) fWriter->WriteBlock(fBlock, fNofRecords);
+  fNofRecords = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
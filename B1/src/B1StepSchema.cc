@@ -0,0 +1,188 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepSchema.cc
+/// \brief Implementation of the B1StepSchema class
+
+#include "B1StepSchema.hh"
+
+namespace
+{
+  struct ColumnKey
+  {
+    G4int       column;
+    const char* key;
+  };
+
+  const ColumnKey kColumnKeys[] = {
+    { B1StepSchema::kParticle,       "particle" },
+    { B1StepSchema::kVolume,         "volume" },
+    { B1StepSchema::kEdep,           "edep" },
+    { B1StepSchema::kKinEnergy,      "ke" },
+    { B1StepSchema::kTime,           "time" },
+    { B1StepSchema::kStepLength,     "steplen" },
+    { B1StepSchema::kMomentum,       "momentum" },
+    { B1StepSchema::kPosition,       "pos" },
+    { B1StepSchema::kLocalPosition,  "localpos" },
+    { B1StepSchema::kMomentumVector, "pxyz" },
+    { B1StepSchema::kTrackID,        "trackid" },
+    { B1StepSchema::kParentID,       "parentid" },
+    { B1StepSchema::kSlice,          "slice" }
+  };
+  const G4int kNofColumnKeys = sizeof(kColumnKeys)/sizeof(kColumnKeys[0]);
+
+  // all the fields in the order of the output; the names of the default
+  // columns are those of the original text descriptor
+  const B1StepField kFields[] = {
+    { 0, "EventID", "EventID", 'I', 4, "",
+      offsetof(B1StepRecord, eventID) },
+    { B1StepSchema::kParticle, "particle", "particle",
+      'C', B1StepRecord::kParticleNameLength, "",
+      offsetof(B1StepRecord, particle) },
+    { B1StepSchema::kVolume, "volumeName", "volumeID", 'I', 4, "",
+      offsetof(B1StepRecord, volumeID) },
+    { B1StepSchema::kEdep, "edepStep_keV", "edepStep", 'D', 8, "keV",
+      offsetof(B1StepRecord, edep) },
+    { B1StepSchema::kKinEnergy, "KEparticle_keV", "KEparticle", 'D', 8, "keV",
+      offsetof(B1StepRecord, kinEnergy) },
+    { B1StepSchema::kTime, "global_t_ns", "global_t", 'D', 8, "ns",
+      offsetof(B1StepRecord, globalTime) },
+    { B1StepSchema::kStepLength, "steplen_mm", "steplen", 'D', 8, "um",
+      offsetof(B1StepRecord, stepLength) },
+    { B1StepSchema::kMomentum, "momentum_keV", "momentum", 'D', 8, "keV",
+      offsetof(B1StepRecord, momentum) },
+    { B1StepSchema::kPosition, "globalx_um", "globalx", 'D', 8, "um",
+      offsetof(B1StepRecord, x) },
+    { B1StepSchema::kPosition, "globaly_um", "globaly", 'D', 8, "um",
+      offsetof(B1StepRecord, y) },
+    { B1StepSchema::kPosition, "globalz_um", "globalz", 'D', 8, "um",
+      offsetof(B1StepRecord, z) },
+    { B1StepSchema::kLocalPosition, "localx_um", "localx", 'D', 8, "um",
+      offsetof(B1StepRecord, localX) },
+    { B1StepSchema::kLocalPosition, "localy_um", "localy", 'D', 8, "um",
+      offsetof(B1StepRecord, localY) },
+    { B1StepSchema::kLocalPosition, "localz_um", "localz", 'D', 8, "um",
+      offsetof(B1StepRecord, localZ) },
+    { B1StepSchema::kMomentumVector, "px_keV", "px", 'D', 8, "keV",
+      offsetof(B1StepRecord, px) },
+    { B1StepSchema::kMomentumVector, "py_keV", "py", 'D', 8, "keV",
+      offsetof(B1StepRecord, py) },
+    { B1StepSchema::kMomentumVector, "pz_keV", "pz", 'D', 8, "keV",
+      offsetof(B1StepRecord, pz) },
+    { B1StepSchema::kTrackID, "trackID", "trackID", 'I', 4, "",
+      offsetof(B1StepRecord, trackID) },
+    { B1StepSchema::kParentID, "parentID", "parentID", 'I', 4, "",
+      offsetof(B1StepRecord, parentID) },
+    { B1StepSchema::kSlice, "sliceID", "sliceID", 'I', 4, "",
+      offsetof(B1StepRecord, sliceID) }
+  };
+  const G4int kNofFields = sizeof(kFields)/sizeof(kFields[0]);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepSchema::B1StepSchema()
+: fColumns(kDefaultColumns)
+{
+  SelectFields();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StepSchema::SetColumns(const G4String& keys)
+{
+  G4int columns = 0;
+
+  std::size_t begin = 0;
+  while ( begin < keys.size() ) {
+    std::size_t end = keys.find_first_of(", ", begin);
+    if ( end == std::string::npos ) end = keys.size();
+    G4String key = keys.substr(begin, end - begin);
+    begin = end + 1;
+    if ( key.empty() ) continue;
+
+    if ( key == "default" ) {
+      columns |= kDefaultColumns;
+      continue;
+    }
+    G4int i = 0;
+    while ( i < kNofColumnKeys && key != kColumnKeys[i].key ) ++i;
+    if ( i == kNofColumnKeys ) {
+      G4ExceptionDescription msg;
+      msg << "Unknown step output column " << key << ", the columns are"
+          << " kept unchanged." << G4endl
+          << "Available columns: " << GetCandidates();
+      G4Exception("B1StepSchema::SetColumns()", "MyCode0005",
+                  JustWarning, msg);
+      return false;
+    }
+    columns |= kColumnKeys[i].column;
+  }
+
+  fColumns = columns;
+  SelectFields();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1StepSchema::GetColumnKeys() const
+{
+  G4String keys;
+  for ( G4int i = 0; i < kNofColumnKeys; ++i ) {
+    if ( ! ( fColumns & kColumnKeys[i].column ) ) continue;
+    if ( ! keys.empty() ) keys.append(",");
+    keys.append(kColumnKeys[i].key);
+  }
+  return keys;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4String B1StepSchema::GetCandidates()
+{
+  G4String candidates = "default";
+  for ( G4int i = 0; i < kNofColumnKeys; ++i ) {
+    candidates.append(" ");
+    candidates.append(kColumnKeys[i].key);
+  }
+  return candidates;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepSchema::SelectFields()
+{
+  fFields.clear();
+  for ( G4int i = 0; i < kNofFields; ++i ) {
+    // the event ID (column 0) is always written
+    if ( kFields[i].column == 0 || ( fColumns & kFields[i].column ) ) {
+      fFields.push_back(&kFields[i]);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,126 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepWriter.cc
+/// \brief Implementation of the B1StepWriter class
+
+#include "B1StepWriter.hh"
+
+#include <cstdio>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepWriter::B1StepWriter(const B1StepSchema& schema)
+: fSchema(schema),
+  fBytesWritten(0)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepWriter::~B1StepWriter()
+{
+  CloseIndex();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StepWriter::MergeFiles(const std::vector<G4String>& inputs,
+                                const G4String& output,
+                                std::vector<G4long>& offsetShifts) const
+{
+  offsetShifts.clear();
+
+  std::ofstream merged(output, std::ios::out | std::ios::binary);
+  if ( ! merged.is_open() ) return false;
+
+  G4long mergedSize = 0;
+  for ( std::size_t i = 0; i < inputs.size(); ++i ) {
+    // a shard that cannot be copied fails the merge, so that the caller
+    // keeps all the shards; the partial output is removed
+    std::ifstream input(inputs[i], std::ios::in | std::ios::binary);
+    G4bool ok = input.is_open();
+    if ( ok && i > 0 ) ok = SkipHeader(input);
+    if ( ! ok ) {
+      merged.close();
+      std::remove(output.c_str());
+      return false;
+    }
+
+    G4long headerSize = ( i > 0 ) ? G4long(input.tellg()) : 0;
+    offsetShifts.push_back(mergedSize - headerSize);
+
+    // streaming an empty buffer would set the failbit of merged
+    if ( input.peek() != std::ifstream::traits_type::eof() ) {
+      merged << input.rdbuf();
+    }
+    mergedSize = merged.tellp();
+  }
+
+  merged.close();
+  return ! merged.fail();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1StepWriter::OpenIndex(const G4String& indexFileName,
+                               const G4String& dataFileName)
+{
+  fIndex.open(indexFileName);
+  if ( ! fIndex.is_open() ) return false;
+
+  fDataFileName = dataFileName;
+  fIndex << "# file offset nofSteps firstEventID lastEventID" << '\n';
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepWriter::CloseIndex()
+{
+  if ( fIndex.is_open() ) fIndex.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepWriter::IndexBlock(G4long offset,
+                              const std::vector<B1StepRecord>& records,
+                              std::size_t nofRecords)
+{
+  if ( ! fIndex.is_open() || nofRecords == 0 ) return;
+
+  // the events of a worker are not consecutive in multi-threading mode
+  G4int firstEventID = records[0].eventID;
+  G4int lastEventID = records[0].eventID;
+  for ( std::size_t i = 1; i < nofRecords; ++i ) {
+    if ( records[i].eventID < firstEventID ) firstEventID = records[i].eventID;
+    if ( records[i].eventID > lastEventID ) lastEventID = records[i].eventID;
+  }
+
+  fIndex << fDataFileName << ' ' << offset << ' ' << nofRecords << ' '
+         << firstEventID << ' ' << lastEventID << '\n';
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,111 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1StepWriterThread.cc
+/// \brief Implementation of the B1StepWriterThread class
+
+#include "B1StepWriterThread.hh"
+#include "B1StepWriter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepWriterThread::B1StepWriterThread(B1StepWriter* writer,
+                                       G4int nofBuffers,
+                                       std::size_t blockSize)
+: fWriter(writer),
+  fStop(false)
+{
+  // the caller holds one of the buffers while filling it
+  for ( G4int i = 1; i < nofBuffers; ++i ) {
+    fFreeBuffers.push_back(std::vector<B1StepRecord>(blockSize));
+  }
+
+  fThread = std::thread(&B1StepWriterThread::Run, this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1StepWriterThread::~B1StepWriterThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fJobReady.notify_one();
+  fThread.join();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepWriterThread::Submit(std::vector<B1StepRecord>& block,
+                                std::size_t nofRecords)
+{
+  if ( nofRecords == 0 ) return;
+
+  std::unique_lock<std::mutex> lock(fMutex);
+
+  // back-pressure: wait until the writer has released a buffer
+  fBufferFree.wait(lock, [this]{ return ! fFreeBuffers.empty(); });
+
+  std::vector<B1StepRecord> empty;
+  empty.swap(fFreeBuffers.back());
+  fFreeBuffers.pop_back();
+
+  fQueue.push_back(Job());
+  fQueue.back().records.swap(block);
+  fQueue.back().nofRecords = nofRecords;
+  block.swap(empty);
+
+  lock.unlock();
+  fJobReady.notify_one();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1StepWriterThread::Run()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  while ( true ) {
+    fJobReady.wait(lock, [this]{ return fStop || ! fQueue.empty(); });
+    if ( fQueue.empty() ) break;
+
+    Job job;
+    job.records.swap(fQueue.front().records);
+    job.nofRecords = fQueue.front().nofRecords;
+    fQueue.pop_front();
+
+    // serialize and write without holding the lock
+    lock.unlock();
+    fWriter->WriteBlock(job.records, job.nofRecords);
+    lock.lock();
+
+    fFreeBuffers.push_back(std::vector<B1StepRecord>());
+    fFreeBuffers.back().swap(job.records);
+    fBufferFree.notify_one();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
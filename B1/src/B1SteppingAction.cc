@@ -29,179 +29,133 @@
 
 #include "B1SteppingAction.hh"
 #include "B1EventAction.hh"
-#include "B1DetectorConstruction.hh"
+#include "B1StepContext.hh"
+#include "B1StepOutput.hh"
+#include "B1StepFilter.hh"
+#include "B1HistogramSet.hh"
+#include "B1TrackKiller.hh"
 
 #include "G4Step.hh"
-#include "G4Event.hh"
-#include "G4RunManager.hh"
 #include "G4LogicalVolume.hh"
 
 #include "G4SystemOfUnits.hh"
 #include "G4VTouchable.hh"
 
-#include<TH1D.h>
-
-using std::cout;
-using std::setw;
-using std::setprecision;
+#include <cstring>
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-    B1SteppingAction::B1SteppingAction(B1EventAction* eventAction)
+    B1SteppingAction::B1SteppingAction(B1EventAction* eventAction,
+                                       B1StepContext* stepContext,
+                                       B1StepOutput* stepOutput,
+                                       B1HistogramSet* histograms,
+                                       B1TrackKiller* trackKiller)
 : G4UserSteppingAction(),
     fEventAction(eventAction),
-    fScoringVolumeEnv(0),
-    fScoringVolume1(0),
-    fScoringVolume2(0)
-{
-    filecount = 0;
-    counter = 0; 
-    OpenOfile();
-    
-
-    //outfile = TFile::Open("output.root");
-    //G4Step* step;
-    //tree->Branch("step",&step);    
-
-
-}
-
-void B1SteppingAction::OpenOfile(){ 
-    std::string name = "run_";
-    name.append(std::to_string(filecount++));
-    name.append(".dat");
-    ofile.open(name);
-    //ofile << " " << setw(5) << "trackid" << " " 
-    ofile  << setw(5) << "EventID/I:" 
-        << setw(5) << "particle/C:"
-        << setw(10) << "volumeName/I:" 
-        << setw(10) << "edepStep_keV/D:"
-        << setw(10) << "KEparticle_keV/D:"
-        << setw(10) << "global_t_ns/D:" 
-        << setw(10) << "steplen_mm/D:" 
-        << setw(10) << "momentum_keV/D:"
-        //<< " " << setw(10) << "momentum.x/keV" << " "
-        //<< " " << setw(10) << "momentum.y/mm" << " "
-        //<< " " << setw(10) << "momentum.z/mm" << " " 
-        << setw(10) << "globalx_um/D:" 
-        << setw(10) << "globaly_um/D:" 
-        << setw(10) << "globalz_um/D"  <<G4endl;
-        //<< " " << setw(10) << "local.x()/mm" << " "
-        //<< " " << setw(10) << "local.y()/mm" << " "
-        //<< " " << setw(10) << "local.z()/mm" << " " << G4endl;
-
-}
-
-void B1SteppingAction::CloseOfile(){ 
-    ofile.close();
-}
-
-
+    fStepContext(stepContext),
+    fStepOutput(stepOutput),
+    fStepFilter(stepOutput->GetStepFilter()),
+    fHistograms(histograms),
+    fTrackKiller(trackKiller)
+{}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 B1SteppingAction::~B1SteppingAction()
 {
-    //ofile.close();
-    CloseOfile();
+    // the output files are closed by B1StepOutput
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void B1SteppingAction::UserSteppingAction(const G4Step* step)
 {
-    if (!fScoringVolumeEnv) { 
-        const B1DetectorConstruction* detectorConstruction
-            = static_cast<const B1DetectorConstruction*>
-            (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-        fScoringVolumeEnv = detectorConstruction->GetScoringVolumeEnv();   
-    }
-    if (!fScoringVolume1) { 
-        const B1DetectorConstruction* detectorConstruction
-            = static_cast<const B1DetectorConstruction*>
-            (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-        fScoringVolume1 = detectorConstruction->GetScoringVolume1();   
-    }
-    if (!fScoringVolume2) { 
-        const B1DetectorConstruction* detectorConstruction
-            = static_cast<const B1DetectorConstruction*>
-            (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
-        fScoringVolume2 = detectorConstruction->GetScoringVolume2();   
-    }
-
     // get volume of the current step
     G4LogicalVolume* volume 
-        = step->GetPreStepPoint()->GetTouchableHandle()
+        = step->GetPreStepPoint()->GetTouchable()
         ->GetVolume()->GetLogicalVolume();
 
-    // check if we are in scoring volume
-    //if (volume != fScoringVolume) return;
+    // world = 0, layers = 1 to N (Al = 1, Ta = 2), envelope = vacuum = N+1
+    G4int volumeName = fStepContext->GetVolumeID(volume);
 
     // collect energy deposited in this step
     G4double edepStep = step->GetTotalEnergyDeposit();
-    fEventAction->AddEdep(edepStep);  
+    fEventAction->AddEdep(volumeName, edepStep);  
 
-    // TESTING ZONE
+    // thread-local histograms, merged at the end of run
+    fHistograms->Fill(step, volumeName);
 
+    // event summary, before the step selection
+    if (fStepOutput->WritesEvents()) fEventAction->AddStep(step, volumeName);
 
-    // Get post-step point
-    G4StepPoint* poststep = step->GetPostStepPoint();
+    // stop the track if it left the region of interest; the step itself
+    // is scored and written
+    if (fTrackKiller->IsActive()) fTrackKiller->Check(step);
 
-    G4ThreeVector poststeppos = poststep->GetPosition(); // position
-    G4double epart = poststep->GetTotalEnergy();         // particle energy
-    G4ThreeVector ppart = poststep->GetMomentum();
+    // check if the step is selected for the output
+    if (!fStepOutput->WritesSteps()) return;
+    if (!fStepFilter->Accept(step, volumeName)) return;
 
+    // fill only the fields of the selected columns
+    const B1StepSchema& schema = fStepOutput->GetSchema();
+    G4StepPoint* poststep = step->GetPostStepPoint();
     G4Track* track = step->GetTrack();
-    //track->SetStepLength(0.005*mm);
-
-    G4int trackid = track->GetTrackID();
-    G4String partname = track->GetParticleDefinition()->GetParticleName();
-    G4double KEparticle = track->GetKineticEnergy();  // get KE of particle along the track in each step
-    G4double steplength = track->GetStepLength();
-    G4String typelim = "proton";
-
-    G4int EventID = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
-    G4TouchableHandle handle = step->GetPreStepPoint()->GetTouchableHandle();
-    G4ThreeVector pos = handle->GetHistory()->GetTopTransform().TransformPoint(step->GetPostStepPoint()->GetPosition());
-
-    G4int volumeName = 0;
-    if(volume==fScoringVolumeEnv) {
-        volumeName = 3; // envelope = vacuum
-    }else if(volume==fScoringVolume1){
-        volumeName = 1; // shape1 = Al
-    }else if(volume==fScoringVolume2){
-        volumeName = 2;  // shape2 = vacuum
-    }else{
-        volumeName = 0; // world = vacuum
-    }
 
-    if (fabs(EventID-counter)>50000){
-        CloseOfile();
-        OpenOfile();
-        counter = EventID;
+    // the files are rotated by B1StepOutput::BeginOfEvent()
+    B1StepRecord& rec = fStepOutput->NextRecord();
+    rec.eventID = fStepContext->GetEventID();
+    if (schema.Has(B1StepSchema::kParticle)) {
+        G4int partid = fStepContext->GetParticleID(track->GetParticleDefinition());
+        std::memcpy(rec.particle, fStepContext->GetParticleName(partid),
+                    B1StepRecord::kParticleNameLength);
+    }
+    rec.volumeID = volumeName;
+    rec.edep = edepStep/keV;
+    if (schema.Has(B1StepSchema::kKinEnergy)) {
+        // KE of particle along the track in each step
+        rec.kinEnergy = track->GetKineticEnergy()/keV;
+    }
+    if (schema.Has(B1StepSchema::kTime)) {
+        rec.globalTime = track->GetGlobalTime()/ns;
+    }
+    if (schema.Has(B1StepSchema::kStepLength)) {
+        rec.stepLength = track->GetStepLength()/micrometer;
+    }
+    if (schema.Has(B1StepSchema::kMomentum)) {
+        rec.momentum = track->GetMomentum().mag()/keV;
+    }
+    if (schema.Has(B1StepSchema::kMomentumVector)) {
+        G4ThreeVector momentum = track->GetMomentum();
+        rec.px = momentum.x()/keV;
+        rec.py = momentum.y()/keV;
+        rec.pz = momentum.z()/keV;
+    }
+    if (schema.Has(B1StepSchema::kPosition)) {
+        G4ThreeVector poststeppos = poststep->GetPosition();
+        rec.x = poststeppos.x()/micrometer;
+        rec.y = poststeppos.y()/micrometer;
+        rec.z = poststeppos.z()/micrometer;
+    }
+    if (schema.Has(B1StepSchema::kLocalPosition)) {
+        // post-step position in the frame of the foil, not of its slice
+        G4ThreeVector pos = fStepContext->GetLocalTransform(
+            step->GetPreStepPoint()->GetTouchable(), volumeName)
+            .TransformPoint(poststep->GetPosition());
+        rec.localX = pos.x()/micrometer;
+        rec.localY = pos.y()/micrometer;
+        rec.localZ = pos.z()/micrometer;
+    }
+    if (schema.Has(B1StepSchema::kTrackID)) {
+        rec.trackID = track->GetTrackID();
+    }
+    if (schema.Has(B1StepSchema::kParentID)) {
+        rec.parentID = track->GetParentID();
+    }
+    if (schema.Has(B1StepSchema::kSlice)) {
+        // replica number of the slice, 0 for the unsliced volumes
+        rec.sliceID = step->GetPreStepPoint()->GetTouchable()->GetCopyNumber();
     }
-    //ofile << " " << setw(5) << trackid << " " 
-    ofile << " " << setw(5) << EventID << " " 
-        << " " << setw(10) << partname << " "
-        //<< " " << setw(10) <<volume->GetName() << " "
-        << " " << setw(10) <<volumeName<< " "
-        << " " << setw(10) << edepStep/keV << " "
-        << " " << setw(10) << KEparticle/keV << " "
-        << " " << setw(10) << track->GetGlobalTime()/ns << " "
-        << " " << setw(10) << steplength/micrometer  << " "
-        << " " << setw(10) << track->GetMomentum().mag()/keV << " "
-        //<< " " << setw(10) << track->GetMomentum().x()/keV << "keV "
-        //<< " " << setw(10) << track->GetMomentum().y()/keV << "keV "
-        //<< " " << setw(10) << track->GetMomentum().z()/keV << "keV "
-        << " " << setw(10) << poststeppos.x()/micrometer  << " "
-        << " " << setw(10) << poststeppos.y()/micrometer  << " "
-        << " " << setw(10) << poststeppos.z()/micrometer  << " "<<G4endl; 
-        //<< " " << setw(10) << pos.x()/micrometer << " "
-        //<< " " << setw(10) << pos.y()/micrometer << " "
-        //<< " " << setw(10) << pos.z()/micrometer << " " << G4endl;
-    //if(KEparticle<1*keV) ofile << G4endl;
-
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
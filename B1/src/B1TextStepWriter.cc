@@ -0,0 +1,175 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TextStepWriter.cc
+/// \brief Implementation of the B1TextStepWriter class
+
+#include "B1TextStepWriter.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+namespace
+{
+  // widths of the setw() columns of the original layout
+  const G4int kEventIDWidth = 5;
+  const G4int kFieldWidth = 10;
+
+  // longest formatted value: a C column or a %g double like -1.23457e+308
+  const std::size_t kMaxValueLength = B1StepRecord::kParticleNameLength;
+
+  // formats the value with the default ostream conversion (%d or %.6g)
+  // and returns the end of the written characters
+  inline char* FormatValue(char* out, const B1StepField& field,
+                           const B1StepRecord& rec)
+  {
+    switch ( field.type ) {
+      case 'I':
+#ifdef __cpp_lib_to_chars
+        return std::to_chars(out, out + kMaxValueLength,
+                             field.Get<G4int>(rec)).ptr;
+#else
+        return out + std::snprintf(out, kMaxValueLength, "%d",
+                                   field.Get<G4int>(rec));
+#endif
+      case 'D':
+#ifdef __cpp_lib_to_chars
+        return std::to_chars(out, out + kMaxValueLength,
+                             field.Get<G4double>(rec),
+                             std::chars_format::general, 6).ptr;
+#else
+        return out + std::snprintf(out, kMaxValueLength, "%.6g",
+                                   field.Get<G4double>(rec));
+#endif
+      default:
+        {
+          const char* value = &field.Get<char>(rec);
+          const void* end = std::memchr(value, '\0', field.width);
+          std::size_t length = end ? static_cast<const char*>(end) - value
+                                   : field.width;
+          std::memcpy(out, value, length);
+          return out + length;
+        }
+    }
+  }
+
+  // writes " " value right-aligned in width " ", as << setw(width) did
+  inline char* PutField(char* out, const B1StepField& field,
+                        const B1StepRecord& rec, G4int width)
+  {
+    *out++ = ' ';
+    char value[kMaxValueLength];
+    G4int length = FormatValue(value, field, rec) - value;
+    for ( G4int i = length; i < width; ++i ) *out++ = ' ';
+    std::memcpy(out, value, length);
+    out += length;
+    *out++ = ' ';
+    return out;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TextStepWriter::B1TextStepWriter(const B1StepSchema& schema)
+: B1StepWriter(schema)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TextStepWriter::~B1TextStepWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TextStepWriter::Open(const G4String& fileName)
+{
+  fFile.open(fileName);
+  if ( ! fFile.is_open() ) return false;
+
+  // TTree::ReadFile descriptor, e.g. EventID/I:particle/C:...:globalz_um/D
+  const std::vector<const B1StepField*>& fields = fSchema.GetFields();
+  for ( std::size_t i = 0; i < fields.size(); ++i ) {
+    if ( i > 0 ) fFile << ':';
+    fFile << fields[i]->name << '/' << fields[i]->type;
+  }
+  fFile << '\n';
+  fBytesWritten = fFile.tellp();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TextStepWriter::WriteBlock(const std::vector<B1StepRecord>& records,
+                                  std::size_t nofRecords)
+{
+  IndexBlock(fBytesWritten, records, nofRecords);
+
+  // the whole block is formatted into the reused buffer and written at
+  // once, without stream formatting and without flush per line
+  const std::vector<const B1StepField*>& fields = fSchema.GetFields();
+  const std::size_t maxLineLength = fields.size()*(kMaxValueLength+2) + 1;
+  if ( fBuffer.size() < nofRecords*maxLineLength ) {
+    fBuffer.resize(nofRecords*maxLineLength);
+  }
+
+  char* out = fBuffer.data();
+  for ( std::size_t i = 0; i < nofRecords; ++i ) {
+    const B1StepRecord& rec = records[i];
+    // the event ID is the first field, in a narrower column
+    out = PutField(out, *fields[0], rec, kEventIDWidth);
+    for ( std::size_t j = 1; j < fields.size(); ++j ) {
+      out = PutField(out, *fields[j], rec, kFieldWidth);
+    }
+    *out++ = '\n';
+  }
+
+  std::size_t size = out - fBuffer.data();
+  fFile.write(fBuffer.data(), size);
+  fBytesWritten += size;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TextStepWriter::SkipHeader(std::istream& input) const
+{
+  input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  return input.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TextStepWriter::Close()
+{
+  if ( fFile.is_open() ) fFile.close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,104 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1ThreadStatistics.cc
+/// \brief Implementation of the B1ThreadStatistics class
+
+#include "B1ThreadStatistics.hh"
+
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ThreadStatistics::B1ThreadStatistics(const G4String& name)
+: G4VAccumulable(name)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1ThreadStatistics::~B1ThreadStatistics()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ThreadStatistics::AddRun(G4int threadID, G4int nofEvents,
+                                G4double runTime)
+{
+  Entry& entry = fEntries[threadID];
+  entry.nofEvents += nofEvents;
+  entry.runTime += runTime;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ThreadStatistics::Merge(const G4VAccumulable& other)
+{
+  const B1ThreadStatistics& otherStatistics
+    = static_cast<const B1ThreadStatistics&>(other);
+  std::map<G4int, Entry>::const_iterator it;
+  for ( it = otherStatistics.fEntries.begin();
+        it != otherStatistics.fEntries.end(); ++it ) {
+    AddRun(it->first, it->second.nofEvents, it->second.runTime);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ThreadStatistics::Reset()
+{
+  fEntries.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1ThreadStatistics::Print() const
+{
+  // nothing to report in sequential mode
+  if ( fEntries.empty() ) return;
+
+  G4double maxTime = 0.;
+  G4double sumTime = 0.;
+  std::map<G4int, Entry>::const_iterator it;
+  G4cout << " Events processed per thread :" << G4endl;
+  for ( it = fEntries.begin(); it != fEntries.end(); ++it ) {
+    G4cout
+       << "   thread " << std::setw(3) << it->first << " : "
+       << std::setw(8) << it->second.nofEvents << " events in "
+       << std::setprecision(3) << it->second.runTime << " s" << G4endl;
+    if ( it->second.runTime > maxTime ) maxTime = it->second.runTime;
+    sumTime += it->second.runTime;
+  }
+
+  // 1 when all the threads are busy until the end of the run
+  if ( maxTime > 0. ) {
+    G4cout
+       << "   thread occupancy (mean/max run time) : "
+       << std::setprecision(3) << sumTime/fEntries.size()/maxTime << G4endl;
+  }
+  G4cout << std::setprecision(6);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
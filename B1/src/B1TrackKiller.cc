@@ -0,0 +1,267 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKiller.cc
+/// \brief Implementation of the B1TrackKiller class
+
+#include "B1TrackKiller.hh"
+#include "B1TrackKillerMessenger.hh"
+#include "B1StepContext.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4UnitsTable.hh"
+
+#include <limits>
+
+namespace
+{
+  const char* kReasonNames[B1TrackKiller::kNofReasons] = {
+    "below the minimum kinetic energy",
+    "beyond the maximum time",
+    "outside the box",
+    "outside the volumes"
+  };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKiller::B1TrackKiller(const G4String& name,
+                             const B1StepContext* stepContext)
+: G4VAccumulable(name),
+  fStepContext(stepContext),
+  fMessenger(0),
+  fIsActive(false),
+  fUseBox(false),
+  fMinKinEnergy(0.),
+  fMaxTime(std::numeric_limits<G4double>::max())
+{
+  fMessenger = new B1TrackKillerMessenger(this);
+  Reset();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKiller::~B1TrackKiller()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::SetBox(const G4ThreeVector& min, const G4ThreeVector& max)
+{
+  fBoxMin = min;
+  fBoxMax = max;
+  fUseBox = true;
+  UpdateActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::SetVolumes(const std::vector<G4int>& volumeIDs)
+{
+  fVolumes.clear();
+  for ( std::size_t i = 0; i < volumeIDs.size(); ++i ) {
+    if ( volumeIDs[i] < 0 ) continue;
+    if ( volumeIDs[i] >= G4int(fVolumes.size()) ) {
+      fVolumes.resize(volumeIDs[i]+1, false);
+    }
+    fVolumes[volumeIDs[i]] = true;
+  }
+  UpdateActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::SetMinKinEnergy(G4double kinEnergy)
+{
+  fMinKinEnergy = kinEnergy;
+  UpdateActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::SetMaxTime(G4double time)
+{
+  // 0 = no time limit
+  fMaxTime = ( time > 0. ) ? time : std::numeric_limits<G4double>::max();
+  UpdateActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::Clear()
+{
+  fUseBox = false;
+  fVolumes.clear();
+  fMinKinEnergy = 0.;
+  fMaxTime = std::numeric_limits<G4double>::max();
+  UpdateActive();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::UpdateActive()
+{
+  fIsActive = fUseBox || ! fVolumes.empty() || fMinKinEnergy > 0.
+              || fMaxTime < std::numeric_limits<G4double>::max();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKiller::Reason B1TrackKiller::Test(G4double kinEnergy, G4double time,
+                                          const G4ThreeVector& position,
+                                          G4int volumeID) const
+{
+  // the cheap criteria first
+  if ( kinEnergy < fMinKinEnergy ) return kLowEnergy;
+  if ( time > fMaxTime ) return kLateTime;
+
+  if ( fUseBox &&
+       ( position.x() < fBoxMin.x() || position.x() > fBoxMax.x() ||
+         position.y() < fBoxMin.y() || position.y() > fBoxMax.y() ||
+         position.z() < fBoxMin.z() || position.z() > fBoxMax.z() ) ) {
+    return kOutsideBox;
+  }
+
+  // a negative volume ID is an unknown volume, not tested
+  if ( ! fVolumes.empty() && volumeID >= 0 &&
+       ( volumeID >= G4int(fVolumes.size()) || ! fVolumes[volumeID] ) ) {
+    return kOutsideVolumes;
+  }
+
+  return kNofReasons;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1TrackKiller::KillAtBirth(const G4Track* track)
+{
+  // the primaries have no touchable yet
+  G4int volumeID = -1;
+  if ( ! fVolumes.empty() && track->GetVolume() ) {
+    volumeID
+      = fStepContext->GetVolumeID(track->GetVolume()->GetLogicalVolume());
+  }
+
+  Reason reason = Test(track->GetKineticEnergy(), track->GetGlobalTime(),
+                       track->GetPosition(), volumeID);
+  if ( reason == kNofReasons ) return false;
+
+  ++fNofKilled[kAtBirth][reason];
+  fKilledEnergy[kAtBirth] += track->GetKineticEnergy();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::Check(const G4Step* step)
+{
+  // the stopped tracks may still have at-rest processes, e.g. e+ annihilation
+  G4Track* track = step->GetTrack();
+  if ( track->GetTrackStatus() != fAlive ) return;
+
+  // the track is leaving the world anyway
+  G4StepPoint* poststep = step->GetPostStepPoint();
+  if ( poststep->GetStepStatus() == fWorldBoundary ) return;
+
+  G4int volumeID = -1;
+  if ( ! fVolumes.empty() ) {
+    volumeID = fStepContext->GetVolumeID(
+      poststep->GetTouchable()->GetVolume()->GetLogicalVolume());
+  }
+
+  Reason reason = Test(track->GetKineticEnergy(), track->GetGlobalTime(),
+                       poststep->GetPosition(), volumeID);
+  if ( reason == kNofReasons ) return;
+
+  track->SetTrackStatus(fStopAndKill);
+  ++fNofKilled[kInFlight][reason];
+  fKilledEnergy[kInFlight] += track->GetKineticEnergy();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::Merge(const G4VAccumulable& other)
+{
+  const B1TrackKiller& otherKiller
+    = static_cast<const B1TrackKiller&>(other);
+  for ( G4int i = 0; i < kNofStages; ++i ) {
+    for ( G4int j = 0; j < kNofReasons; ++j ) {
+      fNofKilled[i][j] += otherKiller.fNofKilled[i][j];
+    }
+    fKilledEnergy[i] += otherKiller.fKilledEnergy[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::Reset()
+{
+  for ( G4int i = 0; i < kNofStages; ++i ) {
+    for ( G4int j = 0; j < kNofReasons; ++j ) {
+      fNofKilled[i][j] = 0;
+    }
+    fKilledEnergy[i] = 0.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKiller::Print() const
+{
+  if ( ! fIsActive ) return;
+
+  G4int nofKilled[kNofStages] = { 0, 0 };
+  for ( G4int i = 0; i < kNofStages; ++i ) {
+    for ( G4int j = 0; j < kNofReasons; ++j ) {
+      nofKilled[i] += fNofKilled[i][j];
+    }
+  }
+
+  G4cout
+     << " Tracks out of the region of interest: "
+     << nofKilled[kAtBirth] << " killed before their first step, "
+     << nofKilled[kInFlight] << " stopped in flight" << G4endl;
+  for ( G4int j = 0; j < kNofReasons; ++j ) {
+    if ( fNofKilled[kAtBirth][j] == 0 && fNofKilled[kInFlight][j] == 0 ) {
+      continue;
+    }
+    G4cout
+       << "   " << kReasonNames[j] << " : "
+       << fNofKilled[kAtBirth][j] << " + " << fNofKilled[kInFlight][j]
+       << G4endl;
+  }
+  G4cout
+     << "   kinetic energy not transported : "
+     << G4BestUnit(fKilledEnergy[kAtBirth] + fKilledEnergy[kInFlight], "Energy")
+     << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,147 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1TrackKillerMessenger.cc
+/// \brief Implementation of the B1TrackKillerMessenger class
+
+#include "B1TrackKillerMessenger.hh"
+#include "B1TrackKiller.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKillerMessenger::B1TrackKillerMessenger(B1TrackKiller* trackKiller)
+: G4UImessenger(),
+  fTrackKiller(trackKiller),
+  fRoiDirectory(0),
+  fBoxCmd(0),
+  fVolumesCmd(0),
+  fMinKinEnergyCmd(0),
+  fMaxTimeCmd(0),
+  fClearCmd(0)
+{
+  fRoiDirectory = new G4UIdirectory("/B1/roi/");
+  fRoiDirectory->SetGuidance("Region of interest: the tracks out of it are killed.");
+  fRoiDirectory->SetGuidance("A track is in it if it passes all the set criteria;");
+  fRoiDirectory->SetGuidance("its killed tracks are counted at the end of run.");
+
+  fBoxCmd = new G4UIcommand("/B1/roi/box",this);
+  fBoxCmd->SetGuidance("Kill the tracks leaving a box of the world frame.");
+  const char* names[] = { "xmin", "xmax", "ymin", "ymax", "zmin", "zmax" };
+  for ( std::size_t i = 0; i < 6; ++i ) {
+    fBoxCmd->SetParameter(new G4UIparameter(names[i],'d',false));
+  }
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultUnit("mm");
+  fBoxCmd->SetParameter(unitPrm);
+  fBoxCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fVolumesCmd = new G4UIcmdWithAString("/B1/roi/volumes",this);
+  fVolumesCmd->SetGuidance("Kill the tracks entering a volume not in the given IDs");
+  fVolumesCmd->SetGuidance("(0 world, 1 to N layers, N+1 envelope).");
+  fVolumesCmd->SetGuidance("\"all\" removes the selection.");
+  fVolumesCmd->SetParameterName("volumeIDs",false);
+  fVolumesCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMinKinEnergyCmd = new G4UIcmdWithADoubleAndUnit("/B1/roi/minKineticEnergy",this);
+  fMinKinEnergyCmd->SetGuidance("Kill the tracks below this kinetic energy; 0 = no limit.");
+  fMinKinEnergyCmd->SetParameterName("minKineticEnergy",false);
+  fMinKinEnergyCmd->SetRange("minKineticEnergy>=0.");
+  fMinKinEnergyCmd->SetUnitCategory("Energy");
+  fMinKinEnergyCmd->SetDefaultUnit("keV");
+  fMinKinEnergyCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/roi/maxTime",this);
+  fMaxTimeCmd->SetGuidance("Kill the tracks beyond this global time; 0 = no limit.");
+  fMaxTimeCmd->SetParameterName("maxTime",false);
+  fMaxTimeCmd->SetRange("maxTime>=0.");
+  fMaxTimeCmd->SetUnitCategory("Time");
+  fMaxTimeCmd->SetDefaultUnit("ns");
+  fMaxTimeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/B1/roi/clear",this);
+  fClearCmd->SetGuidance("Remove all the criteria: no track is killed.");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1TrackKillerMessenger::~B1TrackKillerMessenger()
+{
+  delete fBoxCmd;
+  delete fVolumesCmd;
+  delete fMinKinEnergyCmd;
+  delete fMaxTimeCmd;
+  delete fClearCmd;
+  delete fRoiDirectory;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1TrackKillerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if ( command == fBoxCmd ) {
+    std::istringstream is(newValue);
+    G4double xmin, xmax, ymin, ymax, zmin, zmax;
+    G4String unit;
+    is >> xmin >> xmax >> ymin >> ymax >> zmin >> zmax >> unit;
+    G4double value = G4UIcommand::ValueOf(unit);
+    fTrackKiller->SetBox(G4ThreeVector(xmin, ymin, zmin)*value,
+                         G4ThreeVector(xmax, ymax, zmax)*value);
+  }
+  else if ( command == fVolumesCmd ) {
+    std::istringstream is(newValue);
+    std::vector<G4int> volumeIDs;
+    G4String word;
+    while ( is >> word ) {
+      if ( word == "all" ) {
+        volumeIDs.clear();
+        break;
+      }
+      volumeIDs.push_back(G4UIcommand::ConvertToInt(word));
+    }
+    fTrackKiller->SetVolumes(volumeIDs);
+  }
+  else if ( command == fMinKinEnergyCmd ) {
+    fTrackKiller->SetMinKinEnergy(fMinKinEnergyCmd->GetNewDoubleValue(newValue));
+  }
+  else if ( command == fMaxTimeCmd ) {
+    fTrackKiller->SetMaxTime(fMaxTimeCmd->GetNewDoubleValue(newValue));
+  }
+  else if ( command == fClearCmd ) {
+    fTrackKiller->Clear();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,135 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file B1VacuumTransportModel.cc
+/// \brief Implementation of the B1VacuumTransportModel class
+
+#include "B1VacuumTransportModel.hh"
+#include "B1DetectorConstruction.hh"
+
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4AffineTransform.hh"
+#include "G4SystemOfUnits.hh"
+
+namespace
+{
+  // the particle stops this short of the next surface
+  const G4double kSurfaceMargin = 1*nanometer;
+  // shorter moves are left to the normal transport
+  const G4double kMinDistance = 1*micrometer;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1VacuumTransportModel::B1VacuumTransportModel(
+                          const G4String& name, G4Envelope* envelope,
+                          const B1DetectorConstruction* detector)
+: G4VFastSimulationModel(name, envelope),
+  fDetector(detector),
+  fDistance(0.)
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+B1VacuumTransportModel::~B1VacuumTransportModel()
+{}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1VacuumTransportModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  // the neutral particles already cross the envelope in one step
+  return particle.GetPDGCharge() != 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool B1VacuumTransportModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  // the threshold and the envelope material can change between runs
+  G4double maxDensity = fDetector->GetVacuumDensity();
+  if ( maxDensity <= 0. ) return false;
+  const G4Material* material
+    = fastTrack.GetEnvelopeLogicalVolume()->GetMaterial();
+  if ( material->GetDensity() >= maxDensity ) return false;
+
+  fDistance = DistanceToNextSurface(fastTrack);
+  return fDistance > kMinDistance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void B1VacuumTransportModel::DoIt(const G4FastTrack& fastTrack,
+                                  G4FastStep& fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  G4double length = fDistance - kSurfaceMargin;
+
+  fastStep.ProposePrimaryTrackFinalPosition(
+    fastTrack.GetPrimaryTrackLocalPosition()
+    + length*fastTrack.GetPrimaryTrackLocalDirection());
+  fastStep.ProposePrimaryTrackFinalTime(
+    track->GetGlobalTime() + length/track->GetVelocity());
+  fastStep.ProposePrimaryTrackPathLength(length);
+  fastStep.ProposeTotalEnergyDeposited(0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double B1VacuumTransportModel::DistanceToNextSurface(
+                                   const G4FastTrack& fastTrack) const
+{
+  G4ThreeVector position = fastTrack.GetPrimaryTrackLocalPosition();
+  G4ThreeVector direction = fastTrack.GetPrimaryTrackLocalDirection();
+
+  G4double distance
+    = fastTrack.GetEnvelopeSolid()->DistanceToOut(position, direction);
+
+  // the layers, as in G4NormalNavigation: few daughters, no voxels needed
+  G4LogicalVolume* envelope = fastTrack.GetEnvelopeLogicalVolume();
+  for ( G4int i = 0; i < G4int(envelope->GetNoDaughters()); ++i ) {
+    G4VPhysicalVolume* daughter = envelope->GetDaughter(i);
+    G4AffineTransform transform(daughter->GetRotation(),
+                                daughter->GetTranslation());
+    transform.Invert();
+    G4double toDaughter
+      = daughter->GetLogicalVolume()->GetSolid()->DistanceToIn(
+          transform.TransformPoint(position),
+          transform.TransformAxis(direction));
+    if ( toDaughter < distance ) distance = toDaughter;
+  }
+
+  return distance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......